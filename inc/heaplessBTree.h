@@ -0,0 +1,205 @@
+/**
+ * @file heaplessBTree.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless B+tree module.
+ * Ordered map of tBTreeKey to tListData with O(log n) insert, erase and lookup.
+ * The nodes come from a static array (like the heaplessList nodes), the elements are
+ * kept only in the leaves and the leaves are linked, so a range is a lowerBound and nextIt
+ */
+
+#ifndef HEAPLESSBTREE_H
+#define HEAPLESSBTREE_H
+
+#include "userDefines.h"
+#include "ringBuffer.h"
+
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Constant definitions *********
+ *****************************************/
+
+#if HLL_BTREE_ORDER < 4u
+#error "HLL_BTREE_ORDER must be at least 4"
+#endif
+
+// every node but the root keeps at least this number of keys
+#define HLL_BTREE_MIN_KEYS ((HLL_BTREE_ORDER - 1u) / 2u)
+// the nodes have at least 2 children, so the height never passes the bits of the index
+#define HLL_BTREE_MAX_HEIGHT HLL_INDEX_BITS
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+// the arrays have one extra position, so a node can overflow before it is split
+typedef struct{
+    tBTreeKey keys[HLL_BTREE_ORDER];
+    tListData values[HLL_BTREE_ORDER];     // leaves only
+    tIndex children[HLL_BTREE_ORDER + 1u]; // internal nodes only, children[i] keys < keys[i] <= children[i+1] keys
+    tIndex previousLeaf;
+    tIndex nextLeaf;
+    uint16_t count;                        // number of keys
+    bool isLeaf;
+} heaplessBTreeNode;
+
+typedef struct{
+    heaplessBTreeNode* nodes;
+    ringBuffer allocationTable;
+    tIndex rootIndex;
+    tIndex firstLeafIndex;
+    tIndex lastLeafIndex;
+    tIndex height;     // levels of nodes, 0 when empty
+    uint32_t size;     // number of elements
+    tIndex cMaxLength;
+} heaplessBTree;
+
+// position of one element: the leaf and the key inside it
+typedef struct{
+    tIndex leaf;
+    uint16_t position;
+} heaplessBTreeIt;
+
+/*******************************************************
+ ********** function prototypes - Direct access ********
+ ** Those functions will operate directly in the tree **
+ *******************************************************/
+
+/**
+ * @brief init an empty tree
+ *
+ * @param t pointer to the tree
+ * @param ringBufferArray array used to keep the free nodes (maxSize elements)
+ * @param nodeArray array of nodes (maxSize elements)
+ * @param maxSize number of nodes, each leaf keeps from HLL_BTREE_MIN_KEYS to HLL_BTREE_ORDER - 1 elements
+ */
+HLL_API void heaplessBTree_init(heaplessBTree* t, tIndex* ringBufferArray, heaplessBTreeNode* nodeArray, tIndex maxSize);
+
+/**
+ * @brief add an element, or change its data if the key is already in the tree
+ *
+ * @param t pointer to the tree
+ * @param key key of the element
+ * @param data data of the element
+ * @return true means operation successful
+ * @return false means there are not enough free nodes to split the full ones (the tree is not changed)
+ */
+HLL_API bool heaplessBTree_insert(heaplessBTree* t, tBTreeKey key, tListData data);
+
+/**
+ * @brief find the data of a key
+ *
+ * @param t pointer to the tree
+ * @param key key of the element
+ * @param data output: data of the element (not changed when the key is not found)
+ * @return true means the key was found
+ */
+HLL_API bool heaplessBTree_find(heaplessBTree* t, tBTreeKey key, tListData* data);
+
+/**
+ * @brief remove an element, the nodes left almost empty take keys from a neighbour or are merged
+ *
+ * @param t pointer to the tree
+ * @param key key of the element
+ * @return true means operation successful
+ * @return false means the key is not in the tree
+ */
+HLL_API bool heaplessBTree_erase(heaplessBTree* t, tBTreeKey key);
+
+/**
+ * @brief number of elements in the tree
+ *
+ * @param t pointer to the tree
+ */
+HLL_API uint32_t heaplessBTree_size(heaplessBTree* t);
+
+/*******************************************************
+ ********** function prototypes - Iterator *************
+ ** Those functions will operate directly in the tree **
+ *******************************************************/
+
+/**
+ * @brief Creates a iterator in the smallest key
+ *
+ * @param t pointer to the tree
+ * @param it output: iterator
+ * @return true means operation successful
+ * @return false means the tree is empty
+ */
+HLL_API bool heaplessBTree_initIt(heaplessBTree* t, heaplessBTreeIt* it);
+
+/**
+ * @brief Creates a iterator in the biggest key
+ *
+ * @param t pointer to the tree
+ * @param it output: iterator
+ * @return true means operation successful
+ * @return false means the tree is empty
+ */
+HLL_API bool heaplessBTree_initItEnd(heaplessBTree* t, heaplessBTreeIt* it);
+
+/**
+ * @brief Creates a iterator in the first key that is not smaller than the given one
+ * (the beginning of a range, go with heaplessBTree_nextIt until the end of the range)
+ *
+ * @param t pointer to the tree
+ * @param key smallest key of the range
+ * @param it output: iterator
+ * @return true means operation successful
+ * @return false means all the keys are smaller (or the tree is empty)
+ */
+HLL_API bool heaplessBTree_lowerBound(heaplessBTree* t, tBTreeKey key, heaplessBTreeIt* it);
+
+/**
+ * @brief go to the next key
+ *
+ * @param t pointer to the tree
+ * @param it pointer to the iterator
+ * @return true means operation successful (the element is not the last one)
+ * @return false means operation not successful (the element is the last one) or the iterator is not valid
+ */
+HLL_API bool heaplessBTree_nextIt(heaplessBTree* t, heaplessBTreeIt* it);
+
+/**
+ * @brief go to the previous key
+ *
+ * @param t pointer to the tree
+ * @param it pointer to the iterator
+ * @return true means operation successful (the element is not the first one)
+ * @return false means operation not successful (the element is the first one) or the iterator is not valid
+ */
+HLL_API bool heaplessBTree_previousIt(heaplessBTree* t, heaplessBTreeIt* it);
+
+/**
+ * @brief get the key of the element
+ *
+ * @param t pointer to the tree
+ * @param it pointer to the iterator
+ * @return ~0 when the iterator is not valid
+ */
+HLL_API tBTreeKey heaplessBTree_getItKey(heaplessBTree* t, heaplessBTreeIt* it);
+
+/**
+ * @brief get the data of the element
+ *
+ * @param t pointer to the tree
+ * @param it pointer to the iterator
+ * @return ~0 when the iterator is not valid
+ */
+HLL_API tListData heaplessBTree_getItData(heaplessBTree* t, heaplessBTreeIt* it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessBTree.c"
+#endif
+
+#endif /* HEAPLESSBTREE_H */
@@ -0,0 +1,103 @@
+/**
+ * @file heaplessBlockingQueue.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless blocking queue module.
+ * Thread safe wrapper of heaplessList where the consumers can wait for data and
+ * the producers can wait for free nodes, sleeping in the kernel (linux futex)
+ */
+
+#ifndef HEAPLESSBLOCKINGQUEUE_H
+#define HEAPLESSBLOCKINGQUEUE_H
+
+#include <stdatomic.h>
+#include "userDefines.h"
+#include "heaplessLinkedList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Constant definitions *********
+ *****************************************/
+
+#define HLL_WAIT_FOREVER 0xFFFFFFFFu
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+typedef struct{
+    heaplessList list;
+    _Atomic uint32_t items;        // elements that can be popped (futex word of the consumers)
+    _Atomic uint32_t spaces;       // free nodes that can be appended (futex word of the producers)
+    _Atomic uint32_t itemWaiters;  // consumers sleeping in the kernel
+    _Atomic uint32_t spaceWaiters; // producers sleeping in the kernel
+    _Atomic uint32_t lock;         // 0 unlocked, 1 locked, 2 locked with threads sleeping
+} heaplessBlockingQueue;
+
+/*****************************************
+ ********** function prototypes **********
+ *****************************************/
+
+/**
+ * @brief init an empty blocking queue (same memory used by heaplessList_init)
+ *
+ * @param bq pointer to the queue
+ */
+HLL_API void heaplessBlockingQueue_init(heaplessBlockingQueue* bq, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize);
+
+/**
+ * @brief add data to the end of the queue, waiting for a free node if the queue is full
+ *
+ * @param bq pointer to the queue
+ * @param data to be added
+ * @param timeoutMs maximum time waiting (0 does not wait, HLL_WAIT_FOREVER never gives up)
+ * @return true means the data was added
+ * @return false means the queue was still full after the timeout
+ * OBS: with HLL_EPOCH_READERS it also fails, without waiting, while readers of bq->list hold the removed nodes
+ */
+HLL_API bool heaplessBlockingQueue_appendWait(heaplessBlockingQueue* bq, tListData data, uint32_t timeoutMs);
+
+/**
+ * @brief removes the first element of the queue, waiting for it if the queue is empty
+ *
+ * @param bq pointer to the queue
+ * @param output poped data
+ * @param timeoutMs maximum time waiting (0 does not wait, HLL_WAIT_FOREVER never gives up)
+ * @return true means the output data is valid
+ * @return false means the queue was still empty after the timeout
+ */
+HLL_API bool heaplessBlockingQueue_popWait(heaplessBlockingQueue* bq, tListData* output, uint32_t timeoutMs);
+
+#ifdef HLL_SEGMENTED
+/**
+ * @brief attach more nodes to the list of the queue (heaplessList_addSegment), they are
+ * free spaces for the producers. The segments of bq->list must be changed only with these functions
+ *
+ * @param bq pointer to the queue
+ * @param nodes array of nodes that must live until it is released
+ * @param count number of nodes
+ * @return true means the nodes were attached
+ */
+HLL_API bool heaplessBlockingQueue_addSegment(heaplessBlockingQueue* bq, heaplessListNode* nodes, tIndex count);
+
+/**
+ * @brief detach a segment, only if none of its nodes is in the queue (heaplessList_releaseSegment)
+ *
+ * @param bq pointer to the queue
+ * @param nodes same array given to heaplessBlockingQueue_addSegment
+ * @return true means the array is not used by the queue anymore
+ */
+HLL_API bool heaplessBlockingQueue_releaseSegment(heaplessBlockingQueue* bq, heaplessListNode* nodes);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessBlockingQueue.c"
+#endif
+
+#endif /* HEAPLESSBLOCKINGQUEUE_H */
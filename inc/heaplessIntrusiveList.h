@@ -0,0 +1,169 @@
+/**
+ * @file heaplessIntrusiveList.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless intrusive list module.
+ * The elements are records of the user (structs of any size) with a heaplessListLink
+ * inside them. The list only changes the links, so the records are never copied
+ */
+
+#ifndef HEAPLESSINTRUSIVELIST_H
+#define HEAPLESSINTRUSIVELIST_H
+
+#include <stddef.h>
+#include "userDefines.h"
+#include "ringBuffer.h"
+
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+// member of the user record, the indexes are positions in the array of records
+typedef struct{
+    tIndex previousNode; // the record itself when it is free
+    tIndex nextNode;
+} heaplessListLink;
+
+typedef struct{
+    uint8_t* records;
+    size_t recordSize;  // sizeof the user record
+    size_t linkOffset;  // offsetof the heaplessListLink inside the record
+    ringBuffer allocationTable;
+    tIndex firstNodeIndex;
+    tIndex lastNodeIndex;
+    tIndex cMaxLength;
+} heaplessIntrusiveList;
+
+// init with the type of the record and the name of its heaplessListLink member
+#define HLL_INTRUSIVE_INIT(il, ringBufferArray, recordArray, type, member, maxSize) \
+    heaplessIntrusiveList_init( (il), (ringBufferArray), (recordArray), sizeof(type), offsetof(type, member), (maxSize) )
+
+/*******************************************************
+ ********** function prototypes - Direct access ********
+ ** Those functions will operate directly in the list **
+ *******************************************************/
+
+/**
+ * @brief init an empty intrusive list over an array of user records
+ *
+ * @param il pointer to the list
+ * @param ringBufferArray array used to keep the free records (maxSize elements)
+ * @param recordArray array of user records (maxSize elements)
+ * @param recordSize sizeof one record
+ * @param linkOffset offsetof the heaplessListLink member inside the record
+ * @param maxSize maximum number of records in the list
+ */
+HLL_API void heaplessIntrusiveList_init(heaplessIntrusiveList* il, tIndex* ringBufferArray, void* recordArray,
+                                        size_t recordSize, size_t linkOffset, tIndex maxSize);
+
+/**
+ * @brief take a free record and add it to the end of the list. The caller
+ * writes the data directly in the record (only the link must not be changed)
+ *
+ * @param il pointer to the list
+ * @return pointer to the record. NULL if the list is full
+ */
+HLL_API void* heaplessIntrusiveList_append(heaplessIntrusiveList* il);
+
+/**
+ * @brief getter for the first record of the list
+ *
+ * @param il pointer to the list
+ * @return pointer to the record. NULL if the list is empty
+ */
+HLL_API void* heaplessIntrusiveList_getFirst(heaplessIntrusiveList* il);
+
+/**
+ * @brief remove first record of the list
+ *
+ * @param il pointer to the list
+ * @return true means operation successful
+ * @return false means operation not successful (empty list)
+ */
+HLL_API bool heaplessIntrusiveList_removeFirst(heaplessIntrusiveList* il);
+
+/**
+ * @brief remove last record of the list
+ *
+ * @param il pointer to the list
+ * @return true means operation successful
+ * @return false means operation not successful (empty list)
+ */
+HLL_API bool heaplessIntrusiveList_removeLast(heaplessIntrusiveList* il);
+
+/**
+ * @brief remove a record from any position of the list. O(1)
+ *
+ * @param il pointer to the list
+ * @param record pointer to the record
+ * @return true means operation successful
+ * @return false means the record is not in the list
+ */
+HLL_API bool heaplessIntrusiveList_remove(heaplessIntrusiveList* il, void* record);
+
+/*******************************************************
+ ********** function prototypes - Iterator *************
+ ** Those functions will operate directly in the list **
+ *******************************************************/
+
+/**
+ * @brief Creates a iterator for the list starting from the begginning
+ *
+ * @param il pointer to the list
+ * @return record pointer, NULL if the list is empty
+ */
+HLL_API void* heaplessIntrusiveList_initIt(heaplessIntrusiveList* il);
+
+/**
+ * @brief Creates a iterator for the list starting from the end
+ *
+ * @param il pointer to the list
+ * @return record pointer, NULL if the list is empty
+ */
+HLL_API void* heaplessIntrusiveList_initItEnd(heaplessIntrusiveList* il);
+
+/**
+ * @brief get next record of the list
+ *
+ * @param il pointer to the list
+ * @param record pointer to the record pointer
+ * @return true means operation successful (the record is not the last one)
+ * @return false means operation not successful (the record is the last one)
+ */
+HLL_API bool heaplessIntrusiveList_nextIt(heaplessIntrusiveList* il, void** record);
+
+/**
+ * @brief get previous record of the list
+ *
+ * @param il pointer to the list
+ * @param record pointer to the record pointer
+ * @return true means operation successful (the record is not the first one)
+ * @return false means operation not successful (the record is the first one)
+ */
+HLL_API bool heaplessIntrusiveList_previousIt(heaplessIntrusiveList* il, void** record);
+
+/**
+ * @brief remove the record from the list and go to the next one
+ *
+ * @param il pointer to the list
+ * @param record pointer to the record pointer
+ * OBS: the output record will be NULL if this was the last record
+ */
+HLL_API bool heaplessIntrusiveList_removeAndNextIt(heaplessIntrusiveList* il, void** record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessIntrusiveList.c"
+#endif
+
+#endif /* HEAPLESSINTRUSIVELIST_H */
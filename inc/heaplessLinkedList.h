@@ -14,22 +14,108 @@
 #define NULL_PTR (void*)0u
 #endif
 
+#if defined(HLL_EPOCH_READERS) && ( defined(HLL_SEGMENTED) || defined(HLL_LIFO_ALLOCATION) )
+#error "HLL_EPOCH_READERS keeps the removed nodes in the end of the allocationTable, it needs the FIFO allocation without segments"
+#endif
+
+#if defined(HLL_PARALLEL) && defined(HLL_SEGMENTED)
+#error "HLL_PARALLEL splits the node array given in the init, the segments are not supported"
+#endif
+
+#ifdef HLL_PARALLEL
+// words of the bitmap given to heaplessList_initLiveBitmap
+#define HLL_LIVE_BITMAP_WORDS(maxSize) ( ((maxSize) + 31u) / 32u )
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************
  ********** Type definitions *************
  *****************************************/
 
 typedef struct{
-    tIndex previousNode;
+    HLL_LINK previousNode;
     tListData data;
-    tIndex nextNode;
+    HLL_LINK nextNode;
+#ifdef HLL_STABLE_HANDLES
+    tGeneration generation; // changes every time the node is freed
+#endif
 } heaplessListNode;
 
+#ifdef HLL_STABLE_HANDLES
+// reference to an element that can be kept outside of the list, it fails
+// to resolve after the element is removed, even if its node is reused
+typedef struct{
+    tIndex index;
+    tGeneration generation;
+} heaplessListHandle;
+#endif
+
+#ifdef HLL_EPOCH_READERS
+// one per reader thread, in different cache lines so the readers do not disturb each other
+typedef struct{
+    _Alignas(HLL_CACHE_LINE) _Atomic uint32_t epoch; // 0 means the reader is not in the list
+} heaplessListReader;
+#endif
+
+#ifdef HLL_WATERMARKS
+/**
+ * @brief called when the size of the list reaches the high watermark, and when
+ * it goes back to the low watermark (once each time, the levels between them do nothing).
+ * It is called inside the append/remove, so it must not change the list
+ *
+ * @param isHigh true means the high watermark was reached
+ * @param size number of elements in the list
+ * @param context pointer given to heaplessList_setWatermarks
+ */
+typedef void (*heaplessList_watermarkFunction)(bool isHigh, tIndex size, void* context);
+#endif
+
+#ifdef HLL_SEGMENTED
+// nodes attached with heaplessList_addSegment, they never move while the list is used
+typedef struct{
+    heaplessListNode* nodes;
+    tIndex length;    // 0 means the segment is not used
+    tIndex freeCount;
+    tIndex freeHead;  // the free nodes of the segment are linked by nextNode
+} heaplessListSegment;
+#endif
+
 typedef struct{
     heaplessListNode* linkedList;
     ringBuffer allocationTable;
-    tIndex firstNodeIndex;
-    tIndex lastNodeIndex;
+#ifdef HLL_SENTINEL_NODE
+    tIndex sentinelIndex; // reserved node, its next is the first node and its previous is the last
+#else
+    HLL_LINK firstNodeIndex;
+    HLL_LINK lastNodeIndex;
+#endif
     tIndex cMaxLength;
+    tIndex length;   // elements in the list
+    tIndex capacity; // elements that fit in the nodes (without the sentinel, with the segments)
+#ifdef HLL_WATERMARKS
+    heaplessList_watermarkFunction watermarkCallback; // NULL when the watermarks are not used
+    void* watermarkContext;
+    tIndex highWatermark;
+    tIndex lowWatermark;
+    bool isAboveWatermark; // the high one was reached and the low one was not reached yet
+#endif
+#ifdef HLL_PARALLEL
+    uint32_t* liveBitmap; // bit i set means the node i is in the list, NULL if not used
+#endif
+#ifdef HLL_EPOCH_READERS
+    // the removed nodes are the newest retiredCount indexes of the allocationTable, and the
+    // graceCount oldest of them wait for the readers that started before globalEpoch changed
+    tIndex retiredCount;
+    tIndex graceCount;
+    _Atomic uint32_t globalEpoch;
+    heaplessListReader readers[HLL_MAX_READERS];
+#endif
+#ifdef HLL_SEGMENTED
+    heaplessListSegment segments[HLL_MAX_SEGMENTS]; // the segment 0 is the linkedList
+#endif
 } heaplessList;
 
 /*******************************************************
@@ -39,10 +125,11 @@ typedef struct{
 
 /**
  * @brief init an empty heapless list,
+ * OBS: with HLL_SENTINEL_NODE the last node of heapArray is reserved, so the list holds maxSize-1 elements
  * 
  * @param l pointer to the list
  */
-void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize);
+HLL_API void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize);
 
 /**
  * @brief add data to the list
@@ -52,7 +139,31 @@ void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNod
  * @return true means there was space in the list
  * @return false means the list was full
  */
-bool heaplessList_append(heaplessList* l, tListData data);
+HLL_API bool heaplessList_append(heaplessList* l, tListData data);
+
+/**
+ * @brief number of elements in the list, O(1)
+ * 
+ * @param l pointer to the list
+ */
+HLL_API tIndex heaplessList_size(heaplessList* l);
+
+/**
+ * @brief maximum number of elements, O(1). Without the sentinel node and with the attached segments
+ * 
+ * @param l pointer to the list
+ */
+HLL_API tIndex heaplessList_capacity(heaplessList* l);
+
+/**
+ * @brief tells if all the nodes have elements, then heaplessList_append fails without looking for a node
+ * OBS: with HLL_EPOCH_READERS the append may also fail when the list is not full,
+ * while the removed nodes wait for the readers
+ * 
+ * @param l pointer to the list
+ * @return true means the list is full
+ */
+HLL_API bool heaplessList_isFull(heaplessList* l);
 
 /**
  * @brief removes one list of the element (first), retrieving it to the caller
@@ -62,7 +173,7 @@ bool heaplessList_append(heaplessList* l, tListData data);
  * @return true means the output data is value
  * @return false means the output data is not valid because the list was empty
  */
-bool heaplessList_pop(heaplessList* l, tListData* output);
+HLL_API bool heaplessList_pop(heaplessList* l, tListData* output);
 
 /**
  * @brief getter for the very first element of the list
@@ -72,7 +183,7 @@ bool heaplessList_pop(heaplessList* l, tListData* output);
  * @return true means operation successful
  * @return false means operation not successful
  */
-bool heaplessList_getFirst(heaplessList* l, tListData* output);
+HLL_API bool heaplessList_getFirst(heaplessList* l, tListData* output);
 
 /**
  * @brief remove first element of the list
@@ -81,7 +192,7 @@ bool heaplessList_getFirst(heaplessList* l, tListData* output);
  * @return true means operation successful
  * @return false means operation not successful
  */
-bool heaplessList_removeFirst(heaplessList* l);
+HLL_API bool heaplessList_removeFirst(heaplessList* l);
 
 /**
  * @brief remove last element of the list
@@ -90,7 +201,7 @@ bool heaplessList_removeFirst(heaplessList* l);
  * @return true means operation successful
  * @return false means operation not successful
  */
-bool heaplessList_removeLast(heaplessList* l);
+HLL_API bool heaplessList_removeLast(heaplessList* l);
 
 /*******************************************************
  ********** function prototypes - Iterator *************
@@ -103,7 +214,7 @@ bool heaplessList_removeLast(heaplessList* l);
  * @param l pointer to the list
  * @return node pointer
  */
-heaplessListNode* heaplessList_initIt(heaplessList* l);
+HLL_API heaplessListNode* heaplessList_initIt(heaplessList* l);
 
 
 /**
@@ -112,7 +223,7 @@ heaplessListNode* heaplessList_initIt(heaplessList* l);
  * @param l pointer to the list
  * @return node pointer
  */
-heaplessListNode* heaplessList_initItEnd(heaplessList* l);
+HLL_API heaplessListNode* heaplessList_initItEnd(heaplessList* l);
 
 
 /**
@@ -123,7 +234,7 @@ heaplessListNode* heaplessList_initItEnd(heaplessList* l);
  * @return true means operation successful (the node is not the last one)
  * @return false means operation not successful (the node is the last one)
  */
-bool heaplessList_nextIt(heaplessList* l, heaplessListNode** n);
+HLL_API bool heaplessList_nextIt(heaplessList* l, heaplessListNode** n);
 
 /**
  * @brief get previous node from the heaplessList
@@ -133,7 +244,7 @@ bool heaplessList_nextIt(heaplessList* l, heaplessListNode** n);
  * @return true means operation successful (the node is not the last one)
  * @return false means operation not successful (the node is the last one)
  */
-bool heaplessList_previousIt(heaplessList* l, heaplessListNode** n);
+HLL_API bool heaplessList_previousIt(heaplessList* l, heaplessListNode** n);
 
 /**
  * @brief returns the data from the node
@@ -141,7 +252,7 @@ bool heaplessList_previousIt(heaplessList* l, heaplessListNode** n);
  * @param n pointer to the node
  * @return tListData
  */
-tListData heaplessList_getItData(heaplessListNode* n);
+HLL_API tListData heaplessList_getItData(heaplessListNode* n);
 
 /**
  * @brief remove the element from the list and return de next element
@@ -150,6 +261,156 @@ tListData heaplessList_getItData(heaplessListNode* n);
  * @param n pointer to the node
  * OBS: the output node will be NULL if this is the last node
  */
-bool heaplessList_removeAndNextIt(heaplessList* l, heaplessListNode** n);
+HLL_API bool heaplessList_removeAndNextIt(heaplessList* l, heaplessListNode** n);
+
+#ifdef HLL_PARALLEL
+/**
+ * @brief start keeping the bitmap of the nodes in the list (it can be called at any time)
+ * 
+ * @param l pointer to the list
+ * @param bitmapArray HLL_LIVE_BITMAP_WORDS(maxSize) words, maxSize is the one given to the init
+ */
+HLL_API void heaplessList_initLiveBitmap(heaplessList* l, uint32_t* bitmapArray);
+#endif
+
+#ifdef HLL_WATERMARKS
+/**
+ * @brief call a function when the size reaches the high watermark and when it goes back to
+ * the low one, so the producers can slow down before the list is full. If the list is already
+ * at the high watermark the function is called now
+ * 
+ * @param l pointer to the list
+ * @param high size that calls the function with isHigh true
+ * @param low size that calls the function with isHigh false (smaller than high)
+ * @param callback function to be called, NULL stops the watermarks
+ * @param context pointer given to the function
+ * @return true means operation successful
+ * @return false means the low watermark is not smaller than the high one
+ */
+HLL_API bool heaplessList_setWatermarks(heaplessList* l, tIndex high, tIndex low,
+                                        heaplessList_watermarkFunction callback, void* context);
+#endif
+
+#ifdef HLL_EPOCH_READERS
+/*******************************************************
+ ********** function prototypes - Readers **************
+ ** Those functions let other threads use the iterators *
+ *******************************************************/
+
+/**
+ * @brief start iterating the list from another thread, without locks. Between
+ * readBegin and readEnd the reader can use heaplessList_initIt, initItEnd, nextIt,
+ * previousIt and getItData while one writer thread changes the list
+ * 
+ * @param l pointer to the list
+ * @param reader id of the reader thread (less than HLL_MAX_READERS)
+ * @return true means the reader can iterate the list
+ * @return false means the reader id is not valid
+ */
+HLL_API bool heaplessList_readBegin(heaplessList* l, tIndex reader);
+
+/**
+ * @brief stop iterating, the nodes held by the reader are not used anymore
+ * 
+ * @param l pointer to the list
+ * @param reader id given to heaplessList_readBegin
+ * @return false means the reader id is not valid
+ */
+HLL_API bool heaplessList_readEnd(heaplessList* l, tIndex reader);
+
+/**
+ * @brief give the removed nodes back to the allocationTable when no reader can see them anymore.
+ * Called by the writer when the list looks full, it can be called periodically as well
+ * 
+ * @param l pointer to the list
+ * @return true means some removed nodes can be used again
+ * @return false means the readers still hold the removed nodes (or there are no removed nodes)
+ */
+HLL_API bool heaplessList_reclaim(heaplessList* l);
+#endif
+
+#ifdef HLL_STABLE_HANDLES
+/*******************************************************
+ ********** function prototypes - Handles **************
+ ** Those functions will operate directly in the list **
+ *******************************************************/
+
+/**
+ * @brief get the handle of an element
+ * 
+ * @param l pointer to the list
+ * @param n pointer to the node (from the iterators)
+ * @return handle of the element. Index HLL_NULL if the node is NULL
+ */
+HLL_API heaplessListHandle heaplessList_getHandle(heaplessList* l, heaplessListNode* n);
+
+/**
+ * @brief add data to the list and get the handle of the new element
+ * 
+ * @param l pointer to the list
+ * @param data to be added
+ * @param handle output handle of the element
+ * @return true means there was space in the list
+ * @return false means the list was full
+ */
+HLL_API bool heaplessList_appendWithHandle(heaplessList* l, tListData data, heaplessListHandle* handle);
+
+/**
+ * @brief get the node of the element. O(1)
+ * 
+ * @param l pointer to the list
+ * @param handle handle of the element
+ * @return node pointer. NULL if the element was removed from the list
+ * OBS: the generation of the node wraps around (tGeneration), a stale handle resolves again if its node was reused exactly 2^32 times
+ */
+HLL_API heaplessListNode* heaplessList_resolve(heaplessList* l, heaplessListHandle handle);
+
+/**
+ * @brief remove the element from any position of the list. O(1)
+ * 
+ * @param l pointer to the list
+ * @param handle handle of the element
+ * @return true means operation successful
+ * @return false means the element was already removed
+ */
+HLL_API bool heaplessList_removeByHandle(heaplessList* l, heaplessListHandle handle);
+#endif
+
+#ifdef HLL_SEGMENTED
+/*******************************************************
+ ********** function prototypes - Segments *************
+ ** Those functions change the memory used by the list *
+ *******************************************************/
+
+/**
+ * @brief attach more nodes to a list that is already in use. Nothing is moved,
+ * so the iterators keep valid. The new nodes are used after the ones given in the init
+ * 
+ * @param l pointer to the list
+ * @param nodes array of nodes (static, arena, mmap...) that must live until it is released
+ * @param count number of nodes (less than 2^HLL_SEGMENT_OFFSET_BITS)
+ * @return true means the nodes were attached
+ * @return false means all the segments are in use
+ */
+HLL_API bool heaplessList_addSegment(heaplessList* l, heaplessListNode* nodes, tIndex count);
+
+/**
+ * @brief detach an array given to heaplessList_addSegment, only if none of its nodes is in the list
+ * 
+ * @param l pointer to the list
+ * @param nodes same array given to heaplessList_addSegment
+ * @return true means the array is not used by the list anymore
+ * @return false means the array still has elements of the list (or it was not attached)
+ */
+HLL_API bool heaplessList_releaseSegment(heaplessList* l, heaplessListNode* nodes);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessLinkedList.c"
+#endif
 
 #endif /* HEAPLESSLINKEDLIST_H */
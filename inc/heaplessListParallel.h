@@ -0,0 +1,130 @@
+/**
+ * @file heaplessListParallel.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless list parallel module.
+ * Passes over all the elements of a list when the order does not matter: the node
+ * array is split in chunks that are processed by a small pool of threads (pthreads),
+ * and the free nodes are skipped with the live bitmap of the list (HLL_PARALLEL)
+ */
+
+#ifndef HEAPLESSLISTPARALLEL_H
+#define HEAPLESSLISTPARALLEL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "userDefines.h"
+#include "heaplessLinkedList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef HLL_PARALLEL
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+/**
+ * @brief function called for every element, it can change the data
+ *
+ * @param data pointer to the data inside the node
+ * @param context pointer given by the caller
+ */
+typedef void (*heaplessList_forEachFunction)(tListData* data, void* context);
+
+/**
+ * @brief add one element to a partial result
+ */
+typedef tListReduce (*heaplessList_accumulateFunction)(tListReduce accumulator, tListData data, void* context);
+
+/**
+ * @brief join two partial results (it must be associative and commutative, the chunks end in any order)
+ */
+typedef tListReduce (*heaplessList_combineFunction)(tListReduce a, tListReduce b);
+
+// one pass of heaplessList_parallelForEach or heaplessList_parallelReduce
+typedef struct{
+    heaplessList* list;
+    heaplessList_forEachFunction forEach;       // NULL for the reduce
+    heaplessList_accumulateFunction accumulate;
+    void* context;
+    tListReduce identity;
+    tListReduce partial[HLL_PARALLEL_MAX_THREADS + 1u]; // one per thread that took part, the caller included
+    _Atomic uint32_t numberOfPartials;
+    _Atomic uint32_t nextChunk;
+    uint32_t numberOfChunks;
+} heaplessParallelJob;
+
+typedef struct{
+    pthread_t threads[HLL_PARALLEL_MAX_THREADS];
+    tIndex numberOfThreads; // helpers, the thread that calls the pass works too
+    pthread_mutex_t lock;
+    pthread_cond_t jobReady;
+    pthread_cond_t jobDone;
+    uint32_t jobNumber;     // changes for every pass, so the helpers know there is a new job
+    tIndex runningThreads;  // helpers still working in the current pass
+    bool stop;
+    heaplessParallelJob* job;
+} heaplessParallelPool;
+
+/*****************************************
+ ********** function prototypes **********
+ *****************************************/
+
+/**
+ * @brief start the helper threads
+ *
+ * @param pool pointer to the pool
+ * @param numberOfThreads helpers created (up to HLL_PARALLEL_MAX_THREADS), 0 means the passes are sequential
+ * @return true means all the threads were created
+ * @return false means less threads were created (the pool still works with the ones created)
+ */
+HLL_API bool heaplessParallelPool_init(heaplessParallelPool* pool, tIndex numberOfThreads);
+
+/**
+ * @brief stop and join the helper threads
+ *
+ * @param pool pointer to the pool
+ */
+HLL_API void heaplessParallelPool_shutdown(heaplessParallelPool* pool);
+
+/**
+ * @brief call the function for every element of the list, in any order and from
+ * different threads. The list must not be changed during the pass
+ *
+ * @param l pointer to the list (with heaplessList_initLiveBitmap called)
+ * @param pool pointer to the pool, NULL runs the pass in the caller thread
+ * @param forEach function called for every element
+ * @param context pointer given to the function
+ */
+HLL_API void heaplessList_parallelForEach(heaplessList* l, heaplessParallelPool* pool,
+                                          heaplessList_forEachFunction forEach, void* context);
+
+/**
+ * @brief reduce all the elements of the list to one value, in any order and from
+ * different threads. The list must not be changed during the pass
+ *
+ * @param l pointer to the list (with heaplessList_initLiveBitmap called)
+ * @param pool pointer to the pool, NULL runs the pass in the caller thread
+ * @param identity initial value of every partial result (combine(x, identity) must be x)
+ * @param accumulate function that adds one element to a partial result
+ * @param combine function that joins the partial results
+ * @param context pointer given to accumulate
+ * @return the reduced value (identity if the list is empty)
+ */
+HLL_API tListReduce heaplessList_parallelReduce(heaplessList* l, heaplessParallelPool* pool, tListReduce identity,
+                                                heaplessList_accumulateFunction accumulate,
+                                                heaplessList_combineFunction combine, void* context);
+
+#endif /* HLL_PARALLEL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessListParallel.c"
+#endif
+
+#endif /* HEAPLESSLISTPARALLEL_H */
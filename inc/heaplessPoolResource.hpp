@@ -0,0 +1,137 @@
+/**
+ * @file heaplessPoolResource.hpp
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief std::pmr::memory_resource that gives fixed size blocks of an array of the caller,
+ * with the same free slots ringBuffer of the heaplessList (O(1) allocate and deallocate).
+ * Other sizes, and the blocks asked when the pool is exhausted, come from the upstream resource.
+ * It is not thread safe (like std::pmr::unsynchronized_pool_resource), and ringBuffer.c is
+ * compiled as C and linked (it does not work with HLL_HEADER_ONLY)
+ */
+
+#ifndef HEAPLESSPOOLRESOURCE_HPP
+#define HEAPLESSPOOLRESOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include "userDefines.h"
+#include "ringBuffer.h"
+
+namespace heapless {
+
+class pool_resource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @brief init the pool with all the blocks free
+     *
+     * @param blocks array with blockCount blocks of blockSize bytes
+     * @param blockSize bytes of each block, allocations up to this size use the pool
+     * @param blockCount number of blocks (less than HLL_NULL)
+     * @param freeSlots array used to keep the free blocks (blockCount elements)
+     * @param upstream resource used for the other allocations
+     */
+    pool_resource(void* blocks, std::size_t blockSize, tIndex blockCount, tIndex* freeSlots,
+                  std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : m_blocks(static_cast<unsigned char*>(blocks)), m_blockSize(blockSize), m_blockAlignment(0u),
+          m_blockCount(blockCount), m_highWaterMark(0u), m_upstreamAllocations(0u), m_upstream(upstream)
+    {
+        //check inputs
+        if( nullptr == blocks || nullptr == freeSlots || nullptr == upstream || 0u == blockSize || HLL_NULL == blockCount ){
+            HLL_ASSERT(false,1);
+            m_blockCount = 0u; // everything goes to the upstream
+        }
+
+        // biggest power of 2 that divides the address of every block
+        std::uintptr_t bits = reinterpret_cast<std::uintptr_t>(m_blocks) | m_blockSize;
+        m_blockAlignment = static_cast<std::size_t>( bits & (~bits + 1u) );
+
+        ringBuffer_init( &m_freeSlots, freeSlots, m_blockCount );
+        for( tIndex i = 0; i < m_blockCount; i++ ){
+            ringBuffer_addData( &m_freeSlots, i );
+        }
+    }
+
+    pool_resource(const pool_resource&) = delete;
+    pool_resource& operator=(const pool_resource&) = delete;
+
+    std::size_t block_size() const noexcept { return m_blockSize; }
+
+    tIndex capacity() const noexcept { return m_blockCount; }
+
+    // blocks of the pool given and not deallocated yet
+    tIndex in_use() const noexcept { return static_cast<tIndex>( m_blockCount - m_freeSlots.lenght ); }
+
+    // biggest in_use() since the init (or the last reset_high_water_mark)
+    tIndex high_water_mark() const noexcept { return m_highWaterMark; }
+
+    void reset_high_water_mark() noexcept { m_highWaterMark = in_use(); }
+
+    // allocations sent to the upstream (other sizes or pool exhausted)
+    std::size_t upstream_allocations() const noexcept { return m_upstreamAllocations; }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return m_upstream; }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if( bytes <= m_blockSize && alignment <= m_blockAlignment ){
+            tIndex i = popFreeSlot();
+            if( HLL_NULL != i ){
+                if( in_use() > m_highWaterMark ) m_highWaterMark = in_use();
+                return m_blocks + static_cast<std::size_t>(i) * m_blockSize;
+            }
+        }
+        m_upstreamAllocations++;
+        return m_upstream->allocate( bytes, alignment );
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        if( isInPool(p) ){
+            ringBuffer_addData( &m_freeSlots, static_cast<tIndex>(
+                static_cast<std::size_t>( static_cast<unsigned char*>(p) - m_blocks ) / m_blockSize ) ); // free
+        }
+        else{
+            m_upstream->deallocate( p, bytes, alignment );
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    /**
+     * @brief take a free block, the oldest or the newest one (same choice of the heaplessList)
+     */
+    tIndex popFreeSlot() noexcept
+    {
+#ifdef HLL_LIFO_ALLOCATION
+        return ringBuffer_popLastData( &m_freeSlots );
+#else
+        return ringBuffer_popData( &m_freeSlots );
+#endif
+    }
+
+    bool isInPool(void* p) const noexcept
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+        std::uintptr_t first = reinterpret_cast<std::uintptr_t>(m_blocks);
+        return address >= first && address - first < static_cast<std::uintptr_t>(m_blockCount) * m_blockSize;
+    }
+
+    unsigned char* m_blocks;
+    std::size_t m_blockSize;
+    std::size_t m_blockAlignment;
+    tIndex m_blockCount;
+    tIndex m_highWaterMark;
+    std::size_t m_upstreamAllocations;
+    std::pmr::memory_resource* m_upstream;
+    ringBuffer m_freeSlots;
+};
+
+} // namespace heapless
+
+#endif /* HEAPLESSPOOLRESOURCE_HPP */
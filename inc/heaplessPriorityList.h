@@ -0,0 +1,126 @@
+/**
+ * @file heaplessPriorityList.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless priority list module.
+ * One FIFO lane per priority, all of them taking nodes from the same pool, and a
+ * bitmap of the lanes that are not empty (like the ready list of a RTOS scheduler)
+ */
+
+#ifndef HEAPLESSPRIORITYLIST_H
+#define HEAPLESSPRIORITYLIST_H
+
+#include "userDefines.h"
+#include "ringBuffer.h"
+
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Constant definitions *********
+ *****************************************/
+
+#define HLL_PRIORITY_FREE 0xFFu // priority of the nodes that are not in any lane
+
+#if HLL_PRIORITY_LANES > 32u
+#error "HLL_PRIORITY_LANES must fit in the 32 bits ready bitmap"
+#endif
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+typedef struct{
+    tIndex previousNode;
+    tIndex nextNode;
+    tListData data;
+    uint8_t priority;
+} heaplessPriorityNode;
+
+typedef struct{
+    heaplessPriorityNode* nodes;
+    ringBuffer allocationTable;
+    tIndex firstNodeIndex[HLL_PRIORITY_LANES];
+    tIndex lastNodeIndex[HLL_PRIORITY_LANES];
+    uint32_t readyBitmap; // bit n set means the lane n has elements
+    tIndex cMaxLength;
+} heaplessPriorityList;
+
+/*****************************************
+ ********** function prototypes **********
+ *****************************************/
+
+/**
+ * @brief init an empty priority list, all the lanes share the same node pool
+ *
+ * @param pl pointer to the priority list
+ * @param ringBufferArray array used to keep the free nodes (maxSize elements)
+ * @param nodeArray array of nodes used by all the lanes (maxSize elements)
+ * @param maxSize maximum number of elements in all the lanes
+ */
+HLL_API void heaplessPriorityList_init(heaplessPriorityList* pl, tIndex* ringBufferArray, heaplessPriorityNode* nodeArray, tIndex maxSize);
+
+/**
+ * @brief add data to the end of the lane. O(1)
+ *
+ * @param pl pointer to the priority list
+ * @param priority lane of the data (HLL_PRIORITY_LANES - 1 is the highest)
+ * @param data to be added
+ * @return index of the node, used to change its priority or remove it. HLL_NULL if the list is full
+ */
+HLL_API tIndex heaplessPriorityList_push(heaplessPriorityList* pl, uint8_t priority, tListData data);
+
+/**
+ * @brief removes the first element of the highest priority lane that is not empty. O(1)
+ *
+ * @param pl pointer to the priority list
+ * @param output poped data
+ * @return true means the output data is valid
+ * @return false means the output data is not valid because all the lanes were empty
+ */
+HLL_API bool heaplessPriorityList_pop(heaplessPriorityList* pl, tListData* output);
+
+/**
+ * @brief getter for the element that would be poped
+ *
+ * @param pl pointer to the priority list
+ * @param output returned data
+ * @return true means operation successful
+ * @return false means operation not successful (all the lanes are empty)
+ */
+HLL_API bool heaplessPriorityList_getFirst(heaplessPriorityList* pl, tListData* output);
+
+/**
+ * @brief move an element to the end of another lane. O(1)
+ *
+ * @param pl pointer to the priority list
+ * @param node index returned by heaplessPriorityList_push
+ * @param priority new lane of the element
+ * @return true means operation successful
+ * @return false means the node is not in the list or the priority is not valid
+ */
+HLL_API bool heaplessPriorityList_reprioritize(heaplessPriorityList* pl, tIndex node, uint8_t priority);
+
+/**
+ * @brief remove an element from any position of its lane. O(1)
+ *
+ * @param pl pointer to the priority list
+ * @param node index returned by heaplessPriorityList_push
+ * @return true means operation successful
+ * @return false means the node is not in the list
+ */
+HLL_API bool heaplessPriorityList_remove(heaplessPriorityList* pl, tIndex node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessPriorityList.c"
+#endif
+
+#endif /* HEAPLESSPRIORITYLIST_H */
@@ -0,0 +1,110 @@
+/**
+ * @file heaplessTimerWheel.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless hierarchical timing wheel module
+ */
+
+#ifndef HEAPLESSTIMERWHEEL_H
+#define HEAPLESSTIMERWHEEL_H
+
+#include "userDefines.h"
+#include "ringBuffer.h"
+
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Constant definitions *********
+ *****************************************/
+
+#define HLL_TW_SLOTS (1u << HLL_TW_SLOT_BITS)
+#define HLL_TW_SLOT_MASK (HLL_TW_SLOTS - 1u)
+#define HLL_TW_TOTAL_SLOTS (HLL_TW_LEVELS * HLL_TW_SLOTS)
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+typedef struct{
+    tIndex previousNode;
+    tIndex nextNode;
+    tIndex slot; // slot where the timer is linked, HLL_NULL when the node is free
+    tTimerTick expiry;
+    tListData data;
+} heaplessTimerNode;
+
+typedef struct{
+    heaplessTimerNode* timers;
+    ringBuffer allocationTable;
+    tIndex slotHead[HLL_TW_TOTAL_SLOTS];
+    tTimerTick currentTick;
+    tIndex cMaxLength;
+} heaplessTimerWheel;
+
+/**
+ * @brief function called for every expired timer
+ *
+ * @param timer index returned by heaplessTimerWheel_schedule (already free)
+ * @param data stored when the timer was scheduled
+ */
+typedef void (*heaplessTimerWheel_callback)(tIndex timer, tListData data);
+
+/*****************************************
+ ********** function prototypes **********
+ *****************************************/
+
+/**
+ * @brief init an empty timer wheel, all the slot lists share the same node pool
+ *
+ * @param tw pointer to the timer wheel
+ * @param ringBufferArray array used to keep the free nodes (maxSize elements)
+ * @param timerArray array of nodes used by the timers (maxSize elements)
+ * @param maxSize maximum number of timers running at the same time
+ */
+HLL_API void heaplessTimerWheel_init(heaplessTimerWheel* tw, tIndex* ringBufferArray, heaplessTimerNode* timerArray, tIndex maxSize);
+
+/**
+ * @brief schedule a timer to expire after some ticks. O(1)
+ *
+ * @param tw pointer to the timer wheel
+ * @param delay number of ticks until the expiration (0 is handled as 1)
+ * @param data to be given back on the expiration
+ * @return index of the timer, used to cancel it. HLL_NULL if the wheel is full
+ */
+HLL_API tIndex heaplessTimerWheel_schedule(heaplessTimerWheel* tw, tTimerTick delay, tListData data);
+
+/**
+ * @brief cancel a running timer. O(1)
+ *
+ * @param tw pointer to the timer wheel
+ * @param timer index returned by heaplessTimerWheel_schedule
+ * @return true means the timer was running and it is now cancelled
+ * @return false means the timer was not running (expired or invalid index)
+ */
+HLL_API bool heaplessTimerWheel_cancel(heaplessTimerWheel* tw, tIndex timer);
+
+/**
+ * @brief advance the wheel by one tick, cascading the higher levels when
+ * needed and calling the callback for every expired timer
+ * OBS: the callback can schedule and cancel timers
+ *
+ * @param tw pointer to the timer wheel
+ * @param cb function called for the expired timers (can be NULL)
+ * @return number of expired timers
+ */
+HLL_API tIndex heaplessTimerWheel_tick(heaplessTimerWheel* tw, heaplessTimerWheel_callback cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessTimerWheel.c"
+#endif
+
+#endif /* HEAPLESSTIMERWHEEL_H */
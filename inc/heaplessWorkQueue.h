@@ -0,0 +1,131 @@
+/**
+ * @file heaplessWorkQueue.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief header of the heapless work stealing queue module.
+ * Every worker owns a fixed capacity deque (Chase-Lev): the owner pushes and pops
+ * in the bottom and the other workers steal from the top without locks
+ */
+
+#ifndef HEAPLESSWORKQUEUE_H
+#define HEAPLESSWORKQUEUE_H
+
+#include <stdatomic.h>
+#include "userDefines.h"
+
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************
+ ********** Type definitions *************
+ *****************************************/
+
+// element of the task arrays. Thieves may read it while the owner writes, so it is atomic
+typedef _Atomic(tListData) heaplessWorkItem;
+
+// top and bottom are kept in different cache lines, owner and thieves do not disturb each other
+typedef struct{
+    _Alignas(HLL_CACHE_LINE) _Atomic int_fast64_t top;    // next task to be stolen
+    _Alignas(HLL_CACHE_LINE) _Atomic int_fast64_t bottom; // next free position of the owner
+    heaplessWorkItem* tasks;
+    int_fast64_t cMaxLength;
+} heaplessWorkDeque;
+
+typedef struct{
+    heaplessWorkDeque* deques;
+    tIndex numberOfWorkers;
+    _Atomic int_fast64_t pendingTasks; // pushed and not finished yet
+    _Atomic bool stop;
+} heaplessWorkQueue;
+
+/**
+ * @brief function that executes a task, it can push new tasks to its own worker
+ *
+ * @param wq pointer to the work queue
+ * @param worker id of the worker running the task
+ * @param task to be executed
+ */
+typedef void (*heaplessWorkQueue_handler)(heaplessWorkQueue* wq, tIndex worker, tListData task);
+
+/*****************************************
+ ********** function prototypes **********
+ *****************************************/
+
+/**
+ * @brief init the work queue with empty deques
+ *
+ * @param wq pointer to the work queue
+ * @param dequeArray one deque per worker (numberOfWorkers elements)
+ * @param taskArray memory of all the deques (numberOfWorkers * capacityPerWorker elements)
+ * @param numberOfWorkers number of workers (threads) using the queue
+ * @param capacityPerWorker maximum number of tasks waiting in each deque
+ */
+HLL_API void heaplessWorkQueue_init(heaplessWorkQueue* wq, heaplessWorkDeque* dequeArray, heaplessWorkItem* taskArray,
+                                    tIndex numberOfWorkers, tIndex capacityPerWorker);
+
+/**
+ * @brief add a task in the bottom of the worker deque
+ * OBS: only the owner of the deque can call it (or anyone before the workers start)
+ *
+ * @param wq pointer to the work queue
+ * @param worker owner of the deque
+ * @param task to be added
+ * @return true means there was space in the deque
+ * @return false means the deque was full
+ */
+HLL_API bool heaplessWorkQueue_push(heaplessWorkQueue* wq, tIndex worker, tListData task);
+
+/**
+ * @brief take the newest task from the bottom of the worker deque
+ * OBS: only the owner of the deque can call it
+ *
+ * @param wq pointer to the work queue
+ * @param worker owner of the deque
+ * @param task output
+ * @return true means the output task is valid
+ * @return false means the deque was empty (or the last task was stolen)
+ */
+HLL_API bool heaplessWorkQueue_pop(heaplessWorkQueue* wq, tIndex worker, tListData* task);
+
+/**
+ * @brief take the oldest task from the top of another worker deque, without locks
+ *
+ * @param wq pointer to the work queue
+ * @param victim deque to steal from
+ * @param task output
+ * @return true means the output task is valid
+ * @return false means the deque was empty or another thief won the race
+ */
+HLL_API bool heaplessWorkQueue_steal(heaplessWorkQueue* wq, tIndex victim, tListData* task);
+
+/**
+ * @brief scheduler loop of one worker. It runs its own tasks first and, when
+ * they are over, steals from the deque with more tasks waiting.
+ * Returns when all the pushed tasks were executed or heaplessWorkQueue_stop is called
+ *
+ * @param wq pointer to the work queue
+ * @param worker id of the calling worker
+ * @param handler function executing the tasks
+ */
+HLL_API void heaplessWorkQueue_run(heaplessWorkQueue* wq, tIndex worker, heaplessWorkQueue_handler handler);
+
+/**
+ * @brief ask all the workers to leave heaplessWorkQueue_run
+ *
+ * @param wq pointer to the work queue
+ */
+HLL_API void heaplessWorkQueue_stop(heaplessWorkQueue* wq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#include "../src/heaplessWorkQueue.c"
+#endif
+
+#endif /* HEAPLESSWORKQUEUE_H */
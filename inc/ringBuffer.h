@@ -8,12 +8,25 @@
 #define RINGBUFFER_H
 #include "userDefines.h"
 
+#ifndef NULL_PTR
+#define NULL_PTR (void*)0u
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*****************************************
  ********** Constant definitions *********
  *****************************************/
 
 #define RING_BUFFER_EMPTY 0u
 
+// byte mode: each record starts with its length (one tIndex), and this length
+// means that the records continue in the beginning of the buffer
+#define RING_BUFFER_RECORD_HEADER ((tIndex)sizeof(tIndex))
+#define RING_BUFFER_WRAP_MARKER HLL_NULL
+
 /*****************************************
  ********** Type definitions *************
  *****************************************/
@@ -25,6 +38,18 @@ typedef struct {
   tIndex cMaxlenght;
 } ringBuffer;
 
+// ring of bytes keeping variable length records, written and read in place
+typedef struct {
+  uint8_t* buffer;
+  tIndex tailIndex;      // header of the oldest record
+  tIndex headIndex;      // first free byte
+  tIndex lenght;         // bytes used by records, headers and skipped ends
+  tIndex cMaxlenght;     // multiple of RING_BUFFER_RECORD_HEADER
+  tIndex reservedIndex;  // header position of the reserved record
+  tIndex reservedLenght; // HLL_NULL when there is no reserved record
+  bool isReservedWrapped;
+} ringBufferBytes;
+
 /*****************************************
  ********** function prototypes **********
  *****************************************/
@@ -36,7 +61,7 @@ typedef struct {
  * @param rb [ pointer to the ring buffer to be init ]
  * @return void
  */
-void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxLength);
+HLL_API void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxLength);
 
 /**
  * @brief adds one element to the ring buffer on the first
@@ -47,7 +72,7 @@ void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxLength);
  * @param data [ data to be added ]
  * @return boolean that tells if the operation was OK
  */
-bool ringBuffer_addData(ringBuffer* rb, tIndex data);
+HLL_API bool ringBuffer_addData(ringBuffer* rb, tIndex data);
 
 /**
  * @brief removes the element located on the tail, that
@@ -55,9 +80,109 @@ bool ringBuffer_addData(ringBuffer* rb, tIndex data);
  * {This works as a "malloc" function}
  * 
  * @param rb 
- * @return tIndex with the data. returns 0xFF | 0xFFFF if list is empty 
+ * @return tIndex with the data. returns HLL_NULL if list is empty 
  */
-tIndex ringBuffer_popData(ringBuffer* rb);
+HLL_API tIndex ringBuffer_popData(ringBuffer* rb);
+
+/**
+ * @brief removes the element located on the head, that
+ * means, the last element added to the buffer (LIFO)
+ * {This works as a "malloc" function that reuses the last freed position}
+ * 
+ * @param rb 
+ * @return tIndex with the data. returns HLL_NULL if list is empty 
+ */
+HLL_API tIndex ringBuffer_popLastData(ringBuffer* rb);
+
+/**
+ * @brief adds many elements to the ring buffer at once,
+ * copying at most two contiguous blocks (before and after the end of the array)
+ * 
+ * @param rb [ ring buffer pointer to be added ]
+ * @param data [ array with the elements to be added ]
+ * @param n [ number of elements in data ]
+ * @return number of elements added (less than n if the buffer got full)
+ */
+HLL_API tIndex ringBuffer_addN(ringBuffer* rb, const tIndex* data, tIndex n);
+
+/**
+ * @brief removes many elements from the tail at once (oldest first),
+ * copying at most two contiguous blocks
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @param output [ array that receives the elements ]
+ * @param n [ maximum number of elements to be removed ]
+ * @return number of elements removed (less than n if the buffer got empty)
+ */
+HLL_API tIndex ringBuffer_popN(ringBuffer* rb, tIndex* output, tIndex n);
+
+/**
+ * @brief same as ringBuffer_popN, but the elements are kept in the buffer
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @param output [ array that receives the elements ]
+ * @param n [ maximum number of elements to be copied ]
+ * @return number of elements copied
+ */
+HLL_API tIndex ringBuffer_peekN(ringBuffer* rb, tIndex* output, tIndex n);
+
+/*****************************************
+ ***** function prototypes - byte mode ***
+ *****************************************/
+
+/**
+ * @brief initialization of the ring of bytes (records of variable length)
+ * 
+ * @param rb [ pointer to the ring buffer to be init ]
+ * @param buffer [ memory of the ring, aligned to tIndex ]
+ * @param size [ bytes in buffer (only multiples of RING_BUFFER_RECORD_HEADER are used) ]
+ */
+HLL_API void ringBuffer_initBytes(ringBufferBytes* rb, uint8_t* buffer, tIndex size);
+
+/**
+ * @brief reserve a contiguous space for a new record, so the producer can write
+ * it directly in the buffer. If the space in the end of the buffer is not enough,
+ * the record goes to the beginning. Nothing is visible to the consumer before ringBuffer_commit
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @param len [ maximum length of the record ]
+ * @return pointer to len writable bytes. NULL_PTR if there is no space
+ */
+HLL_API uint8_t* ringBuffer_reserve(ringBufferBytes* rb, tIndex len);
+
+/**
+ * @brief publish the reserved record to the consumer
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @param len [ bytes really written, up to the reserved length ]
+ * @return boolean that tells if the operation was OK (false if nothing was reserved)
+ */
+HLL_API bool ringBuffer_commit(ringBufferBytes* rb, tIndex len);
+
+/**
+ * @brief get the oldest record, to be read in place
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @param len [ output: length of the record ]
+ * @return pointer to the record. NULL_PTR if there are no records
+ */
+HLL_API uint8_t* ringBuffer_peek(ringBufferBytes* rb, tIndex* len);
+
+/**
+ * @brief remove the oldest record (the one given by ringBuffer_peek)
+ * 
+ * @param rb [ ring buffer pointer ]
+ * @return boolean that tells if the operation was OK (false if there are no records)
+ */
+HLL_API bool ringBuffer_release(ringBufferBytes* rb);
+
+
+#ifdef __cplusplus
+}
+#endif
 
+#ifdef HLL_HEADER_ONLY
+#include "../src/ringBuffer.c"
+#endif
 
 #endif /* RINGBUFFER_H */
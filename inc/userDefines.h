@@ -19,10 +19,99 @@
 // This is the type of data stored inside the linked list
 // It does not support strucs, but maybe you can store a pointer
 typedef uint16_t tListData;
-#define HLL_NULL 0xFFFF
 
 // Depends on the maximum number of elements in the list/array
+// Define HLL_LARGE_CAPACITY for lists with more than 65534 elements (32 bits indexes)
+#ifdef HLL_LARGE_CAPACITY
+typedef uint32_t tIndex;
+#define HLL_INDEX_BITS 32u
+#else
 typedef uint16_t tIndex;
+#define HLL_INDEX_BITS 16u
+#endif
+
+// Invalid index (the biggest value of tIndex), so the list holds up to HLL_NULL - 1 elements
+#define HLL_NULL ((tIndex)~(tIndex)0u)
+
+// Uncomment to reuse first the node freed most recently (instead of the oldest one)
+// Big lists used as queues then keep working in the same nodes, which are still in the cache
+// #define HLL_LIFO_ALLOCATION
+
+// Uncomment to attach more node arrays to a list at runtime (heaplessList_addSegment)
+// The higher HLL_SEGMENT_BITS of the index select the array, so each array holds less than 2^(HLL_INDEX_BITS - HLL_SEGMENT_BITS) nodes
+// #define HLL_SEGMENTED
+#define HLL_SEGMENT_BITS 3u
+#define HLL_MAX_SEGMENTS (1u << HLL_SEGMENT_BITS)
+#define HLL_SEGMENT_OFFSET_BITS (HLL_INDEX_BITS - HLL_SEGMENT_BITS)
+#define HLL_SEGMENT_OFFSET_MASK ((1u << HLL_SEGMENT_OFFSET_BITS) - 1u)
+
+// Uncomment to keep a generation counter in each node, so heaplessListHandle can refer to
+// an element and detect when it was removed (the node may be reused by another element)
+// #define HLL_STABLE_HANDLES
+// Type of the generation counter, it wraps around after 2^32 reuses of a node (a stale handle of it would resolve again)
+typedef uint32_t tGeneration;
+
+// Uncomment to let other threads iterate the list without locks while one thread changes it
+// (heaplessList_readBegin/readEnd). Removed nodes are reused only after the readers that may see them are gone
+// #define HLL_EPOCH_READERS
+#define HLL_MAX_READERS 8u
+#ifdef HLL_EPOCH_READERS
+#include <stdatomic.h>
+#define HLL_LINK _Atomic(tIndex)
+#else
+#define HLL_LINK tIndex
+#endif
+
+// Uncomment to call a function when the list reaches a high size and when it goes back
+// to a low size (heaplessList_setWatermarks), so the producers can slow down before the list is full
+// #define HLL_WATERMARKS
+
+// Uncomment to keep a bitmap of the nodes in the list, so heaplessList_parallelForEach and
+// heaplessList_parallelReduce split the node array between threads (heaplessListParallel.h)
+// #define HLL_PARALLEL
+#define HLL_PARALLEL_MAX_THREADS 16u
+#define HLL_PARALLEL_CHUNK 4096u // nodes of each piece of work, multiple of 32 (one bitmap word)
+// Type of the result of heaplessList_parallelReduce
+typedef uint32_t tListReduce;
+
+// Size of the cache line, data written by different threads is kept in different lines
+#ifndef HLL_CACHE_LINE
+#define HLL_CACHE_LINE 64
+#endif
+
+// Uncomment to keep the list as a circle closed by a reserved node (the last one of heapArray)
+// Inserting and removing will be always the same sequence, without first/last special cases
+// #define HLL_SENTINEL_NODE
+
+// Type used to count the ticks of the heaplessTimerWheel
+// The wheel covers delays up to 2^(HLL_TW_LEVELS * HLL_TW_SLOT_BITS) ticks,
+// longer delays are cascaded again when they reach the last level
+typedef uint32_t tTimerTick;
+#define HLL_TW_LEVELS 4u
+#define HLL_TW_SLOT_BITS 6u
+
+// Number of priority lanes of the heaplessPriorityList (up to 32, one bit of the ready bitmap each)
+#define HLL_PRIORITY_LANES 32u
+
+// Type of the keys of the heaplessBTree (any integer type, the values are tListData)
+typedef uint32_t tBTreeKey;
+// Maximum number of children of a heaplessBTree node (at least 4), the leaves keep up to HLL_BTREE_ORDER - 1 keys
+#define HLL_BTREE_ORDER 16u
+
+// Count leading zeros of a 32 bits value different from 0, depends on the compiler
+#if defined(__GNUC__) && __SIZEOF_INT__ >= 4
+#define HLL_CLZ32(x) ((uint32_t)__builtin_clz(x))
+#else
+static inline uint32_t HLL_CLZ32(uint32_t x){ uint32_t n = 0u; while( 0u == (x & 0x80000000u) ){ x <<= 1; n++; } return n; }
+#endif
+
+// Define HLL_HEADER_ONLY to use the library only with the headers (the sources are included by them),
+// then every function is static inline and the hot paths can be inlined in the caller
+#ifdef HLL_HEADER_ONLY
+#define HLL_API static inline
+#else
+#define HLL_API
+#endif
 
 // Asserts depends on the environment
 #define HLL_ASSERT(c,n) !c ? printf("ASSERT: error number %d", n) /*print error*/ : false /*dummy statement*/ ;
@@ -0,0 +1,508 @@
+/**
+ * @file heaplessBTree.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief heapless B+tree implementation.
+ * The insert and the erase go down keeping the path, and fix the nodes from the
+ * leaf to the root: full nodes are split, almost empty nodes take a key from
+ * a neighbour or are merged with it
+ * @version 0.1
+ */
+
+#include <string.h>
+#include "heaplessBTree.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+inline static heaplessBTreeNode* btreeNodeAt(heaplessBTree* t, tIndex i)
+{
+    return &(t->nodes[i]);
+}
+
+/**
+ * @brief first position with a key not smaller than the given one (binary search)
+ */
+inline static uint16_t btreeLowerBound(heaplessBTreeNode* n, tBTreeKey key)
+{
+    uint16_t first = 0u;
+    uint16_t last = n->count;
+    uint16_t middle;
+
+    while( first < last ){
+        middle = (uint16_t)( (first + last) / 2u );
+        if( n->keys[middle] < key ) first = (uint16_t)( middle + 1u );
+        else last = middle;
+    }
+    return first;
+}
+
+/**
+ * @brief first position with a key bigger than the given one, it is the child where the key is
+ */
+inline static uint16_t btreeUpperBound(heaplessBTreeNode* n, tBTreeKey key)
+{
+    uint16_t first = 0u;
+    uint16_t last = n->count;
+    uint16_t middle;
+
+    while( first < last ){
+        middle = (uint16_t)( (first + last) / 2u );
+        if( n->keys[middle] <= key ) first = (uint16_t)( middle + 1u );
+        else last = middle;
+    }
+    return first;
+}
+
+/**
+ * @brief take a free node, the caller already checked that there is one
+ */
+inline static tIndex btreeAllocNode(heaplessBTree* t, bool isLeaf)
+{
+    tIndex i = ringBuffer_popData( &(t->allocationTable) ); // malloc
+    heaplessBTreeNode* n = btreeNodeAt(t, i);
+
+    n->count = 0u;
+    n->isLeaf = isLeaf;
+    n->previousLeaf = HLL_NULL;
+    n->nextLeaf = HLL_NULL;
+    return i;
+}
+
+/**
+ * @brief go down to the leaf where the key is (or should be)
+ *
+ * @param path output: node of each level, from the root to the leaf (NULL_PTR if not needed)
+ * @param positions output: child taken in each level
+ * @return index of the leaf
+ */
+inline static tIndex btreeFindLeaf(heaplessBTree* t, tBTreeKey key, tIndex* path, uint16_t* positions)
+{
+    tIndex i = t->rootIndex;
+    tIndex level = 0u;
+    heaplessBTreeNode* n = btreeNodeAt(t, i);
+    uint16_t position;
+
+    while( !n->isLeaf ){
+        position = btreeUpperBound(n, key);
+        if( NULL_PTR != path ){
+            path[level] = i;
+            positions[level] = position;
+        }
+        i = n->children[position];
+        n = btreeNodeAt(t, i);
+        level++;
+    }
+    if( NULL_PTR != path ){
+        path[level] = i;
+    }
+    return i;
+}
+
+/**
+ * @brief split the node with HLL_BTREE_ORDER keys, from the leaf up to the root
+ * while the parent gets full with the new key
+ *
+ * @param level level of the leaf in the path
+ */
+static void btreeSplit(heaplessBTree* t, tIndex* path, uint16_t* positions, tIndex level)
+{
+    heaplessBTreeNode* n = btreeNodeAt(t, path[level]);
+    heaplessBTreeNode* right;
+    heaplessBTreeNode* root;
+    tIndex rightIndex;
+    tIndex rootIndex;
+    tBTreeKey separator;
+    uint16_t half = (uint16_t)( HLL_BTREE_ORDER / 2u );
+    uint16_t position;
+
+    while( HLL_BTREE_ORDER == n->count ){
+        rightIndex = btreeAllocNode(t, n->isLeaf);
+        right = btreeNodeAt(t, rightIndex);
+
+        if( n->isLeaf ){
+            // the separator is copied, all the keys stay in the leaves
+            right->count = (uint16_t)( HLL_BTREE_ORDER - half );
+            memcpy( right->keys, &(n->keys[half]), right->count * sizeof(tBTreeKey) );
+            memcpy( right->values, &(n->values[half]), right->count * sizeof(tListData) );
+            separator = right->keys[0];
+
+            right->previousLeaf = path[level];
+            right->nextLeaf = n->nextLeaf;
+            if( HLL_NULL == n->nextLeaf )
+                t->lastLeafIndex = rightIndex;
+            else
+                btreeNodeAt(t, n->nextLeaf)->previousLeaf = rightIndex;
+            n->nextLeaf = rightIndex;
+        }
+        else{
+            // the separator goes up
+            separator = n->keys[half];
+            right->count = (uint16_t)( HLL_BTREE_ORDER - half - 1u );
+            memcpy( right->keys, &(n->keys[half + 1u]), right->count * sizeof(tBTreeKey) );
+            memcpy( right->children, &(n->children[half + 1u]), (right->count + 1u) * sizeof(tIndex) );
+        }
+        n->count = half;
+
+        if( 0u == level ){ // the root was split, the tree grows
+            rootIndex = btreeAllocNode(t, false);
+            root = btreeNodeAt(t, rootIndex);
+            root->count = 1u;
+            root->keys[0] = separator;
+            root->children[0] = path[0];
+            root->children[1] = rightIndex;
+            t->rootIndex = rootIndex;
+            t->height++;
+            n = root;
+        }
+        else{
+            level--;
+            n = btreeNodeAt(t, path[level]);
+            position = positions[level];
+            memmove( &(n->keys[position + 1u]), &(n->keys[position]), (n->count - position) * sizeof(tBTreeKey) );
+            memmove( &(n->children[position + 2u]), &(n->children[position + 1u]), (n->count - position) * sizeof(tIndex) );
+            n->keys[position] = separator;
+            n->children[position + 1u] = rightIndex;
+            n->count++;
+        }
+    }
+}
+
+/**
+ * @brief join the children s and s + 1 of the parent in the child s
+ */
+static void btreeMerge(heaplessBTree* t, heaplessBTreeNode* parent, uint16_t s)
+{
+    tIndex leftIndex = parent->children[s];
+    tIndex rightIndex = parent->children[s + 1u];
+    heaplessBTreeNode* left = btreeNodeAt(t, leftIndex);
+    heaplessBTreeNode* right = btreeNodeAt(t, rightIndex);
+
+    if( left->isLeaf ){
+        memcpy( &(left->keys[left->count]), right->keys, right->count * sizeof(tBTreeKey) );
+        memcpy( &(left->values[left->count]), right->values, right->count * sizeof(tListData) );
+        left->count = (uint16_t)( left->count + right->count );
+
+        left->nextLeaf = right->nextLeaf;
+        if( HLL_NULL == right->nextLeaf )
+            t->lastLeafIndex = leftIndex;
+        else
+            btreeNodeAt(t, right->nextLeaf)->previousLeaf = leftIndex;
+    }
+    else{
+        left->keys[left->count] = parent->keys[s]; // the separator comes down
+        memcpy( &(left->keys[left->count + 1u]), right->keys, right->count * sizeof(tBTreeKey) );
+        memcpy( &(left->children[left->count + 1u]), right->children, (right->count + 1u) * sizeof(tIndex) );
+        left->count = (uint16_t)( left->count + right->count + 1u );
+    }
+    ringBuffer_addData( &(t->allocationTable), rightIndex ); // free
+
+    memmove( &(parent->keys[s]), &(parent->keys[s + 1u]), (parent->count - s - 1u) * sizeof(tBTreeKey) );
+    memmove( &(parent->children[s + 1u]), &(parent->children[s + 2u]), (parent->count - s - 1u) * sizeof(tIndex) );
+    parent->count--;
+}
+
+/**
+ * @brief the child c of the parent has less than HLL_BTREE_MIN_KEYS keys,
+ * it takes one key from a neighbour with spare keys or it is merged with one
+ */
+static void btreeRebalance(heaplessBTree* t, heaplessBTreeNode* parent, uint16_t c)
+{
+    heaplessBTreeNode* n = btreeNodeAt(t, parent->children[c]);
+    heaplessBTreeNode* left = ( c > 0u ) ? btreeNodeAt(t, parent->children[c - 1u]) : NULL_PTR;
+    heaplessBTreeNode* right = ( c < parent->count ) ? btreeNodeAt(t, parent->children[c + 1u]) : NULL_PTR;
+
+    if( NULL_PTR != left && left->count > HLL_BTREE_MIN_KEYS ){ // the last key of the left one
+        memmove( &(n->keys[1]), n->keys, n->count * sizeof(tBTreeKey) );
+        if( n->isLeaf ){
+            memmove( &(n->values[1]), n->values, n->count * sizeof(tListData) );
+            n->keys[0] = left->keys[left->count - 1u];
+            n->values[0] = left->values[left->count - 1u];
+            parent->keys[c - 1u] = n->keys[0];
+        }
+        else{
+            memmove( &(n->children[1]), n->children, (n->count + 1u) * sizeof(tIndex) );
+            n->keys[0] = parent->keys[c - 1u];
+            n->children[0] = left->children[left->count];
+            parent->keys[c - 1u] = left->keys[left->count - 1u];
+        }
+        left->count--;
+        n->count++;
+    }
+    else if( NULL_PTR != right && right->count > HLL_BTREE_MIN_KEYS ){ // the first key of the right one
+        if( n->isLeaf ){
+            n->keys[n->count] = right->keys[0];
+            n->values[n->count] = right->values[0];
+            memmove( right->values, &(right->values[1]), (right->count - 1u) * sizeof(tListData) );
+            memmove( right->keys, &(right->keys[1]), (right->count - 1u) * sizeof(tBTreeKey) );
+            parent->keys[c] = right->keys[0];
+        }
+        else{
+            n->keys[n->count] = parent->keys[c];
+            n->children[n->count + 1u] = right->children[0];
+            parent->keys[c] = right->keys[0];
+            memmove( right->keys, &(right->keys[1]), (right->count - 1u) * sizeof(tBTreeKey) );
+            memmove( right->children, &(right->children[1]), right->count * sizeof(tIndex) );
+        }
+        right->count--;
+        n->count++;
+    }
+    else if( NULL_PTR != left ){
+        btreeMerge(t, parent, (uint16_t)( c - 1u ));
+    }
+    else{
+        btreeMerge(t, parent, c);
+    }
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessBTree_init(heaplessBTree* t, tIndex* ringBufferArray, heaplessBTreeNode* nodeArray, tIndex maxSize)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == t || NULL_PTR == ringBufferArray || NULL_PTR == nodeArray || 0u == maxSize ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    t->nodes = nodeArray;
+    t->cMaxLength = maxSize;
+    t->rootIndex = HLL_NULL;
+    t->firstLeafIndex = HLL_NULL;
+    t->lastLeafIndex = HLL_NULL;
+    t->height = 0u;
+    t->size = 0u;
+    ringBuffer_init( &(t->allocationTable), ringBufferArray, maxSize );
+
+    // add the list of free nodes in the ringBuffer
+    for( i = 0; i < maxSize; i++ ){
+        ringBuffer_addData( &(t->allocationTable), i );
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_insert(heaplessBTree* t, tBTreeKey key, tListData data)
+{
+    bool isOperationOk = false;
+    tIndex path[HLL_BTREE_MAX_HEIGHT];
+    uint16_t positions[HLL_BTREE_MAX_HEIGHT];
+    tIndex neededNodes = 0u;
+    tIndex level;
+    heaplessBTreeNode* n;
+    uint16_t position;
+
+    if( HLL_NULL == t->rootIndex && RING_BUFFER_EMPTY != t->allocationTable.lenght ){
+        t->rootIndex = btreeAllocNode(t, true); // very first element case
+        t->firstLeafIndex = t->rootIndex;
+        t->lastLeafIndex = t->rootIndex;
+        t->height = 1u;
+    }
+    if( HLL_NULL == t->rootIndex ){
+        return false;
+    }
+
+    n = btreeNodeAt(t, btreeFindLeaf(t, key, path, positions));
+    position = btreeLowerBound(n, key);
+
+    if( position < n->count && key == n->keys[position] ){
+        n->values[position] = data;
+        isOperationOk = true;
+    }
+    else{
+        // every full node from the leaf up is split, and the root split needs one more node
+        for( level = t->height; level > 0u && HLL_BTREE_ORDER - 1u == btreeNodeAt(t, path[level - 1u])->count; level-- ){
+            neededNodes++;
+        }
+        if( 0u == level ){
+            neededNodes++;
+        }
+
+        if( neededNodes <= t->allocationTable.lenght ){
+            memmove( &(n->keys[position + 1u]), &(n->keys[position]), (n->count - position) * sizeof(tBTreeKey) );
+            memmove( &(n->values[position + 1u]), &(n->values[position]), (n->count - position) * sizeof(tListData) );
+            n->keys[position] = key;
+            n->values[position] = data;
+            n->count++;
+            t->size++;
+            btreeSplit(t, path, positions, (tIndex)( t->height - 1u ));
+            isOperationOk = true;
+        }
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_find(heaplessBTree* t, tBTreeKey key, tListData* data)
+{
+    bool wasKeyFound = false;
+    heaplessBTreeNode* n;
+    uint16_t position;
+
+    if( HLL_NULL != t->rootIndex ){
+        n = btreeNodeAt(t, btreeFindLeaf(t, key, NULL_PTR, NULL_PTR));
+        position = btreeLowerBound(n, key);
+        if( position < n->count && key == n->keys[position] ){
+            *data = n->values[position];
+            wasKeyFound = true;
+        }
+    }
+    return wasKeyFound;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_erase(heaplessBTree* t, tBTreeKey key)
+{
+    bool isOperationOk = false;
+    tIndex path[HLL_BTREE_MAX_HEIGHT];
+    uint16_t positions[HLL_BTREE_MAX_HEIGHT];
+    tIndex level;
+    tIndex rootIndex;
+    heaplessBTreeNode* n;
+    uint16_t position;
+
+    if( HLL_NULL == t->rootIndex ){
+        return false;
+    }
+
+    n = btreeNodeAt(t, btreeFindLeaf(t, key, path, positions));
+    position = btreeLowerBound(n, key);
+
+    if( position < n->count && key == n->keys[position] ){
+        memmove( &(n->keys[position]), &(n->keys[position + 1u]), (n->count - position - 1u) * sizeof(tBTreeKey) );
+        memmove( &(n->values[position]), &(n->values[position + 1u]), (n->count - position - 1u) * sizeof(tListData) );
+        n->count--;
+        t->size--;
+
+        // the parents may get almost empty with the merges
+        for( level = (tIndex)( t->height - 1u ); level > 0u && n->count < HLL_BTREE_MIN_KEYS; level-- ){
+            n = btreeNodeAt(t, path[level - 1u]);
+            btreeRebalance(t, n, positions[level - 1u]);
+        }
+
+        rootIndex = t->rootIndex;
+        n = btreeNodeAt(t, rootIndex);
+        if( 0u == n->count ){
+            if( n->isLeaf ){ // last element
+                t->rootIndex = HLL_NULL;
+                t->firstLeafIndex = HLL_NULL;
+                t->lastLeafIndex = HLL_NULL;
+            }
+            else{ // the tree gets shorter
+                t->rootIndex = n->children[0];
+            }
+            t->height--;
+            ringBuffer_addData( &(t->allocationTable), rootIndex ); // free
+        }
+        isOperationOk = true;
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API uint32_t heaplessBTree_size(heaplessBTree* t)
+{
+    return t->size;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_initIt(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    it->leaf = t->firstLeafIndex;
+    it->position = 0u;
+    return HLL_NULL != it->leaf;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_initItEnd(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    it->leaf = t->lastLeafIndex;
+    it->position = ( HLL_NULL == it->leaf ) ? 0u : (uint16_t)( btreeNodeAt(t, it->leaf)->count - 1u );
+    return HLL_NULL != it->leaf;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_lowerBound(heaplessBTree* t, tBTreeKey key, heaplessBTreeIt* it)
+{
+    bool isOperationOk = false;
+    heaplessBTreeNode* n;
+
+    it->leaf = HLL_NULL;
+    it->position = 0u;
+    if( HLL_NULL != t->rootIndex ){
+        it->leaf = btreeFindLeaf(t, key, NULL_PTR, NULL_PTR);
+        n = btreeNodeAt(t, it->leaf);
+        it->position = btreeLowerBound(n, key);
+        if( it->position < n->count ){
+            isOperationOk = true;
+        }
+        else if( HLL_NULL != n->nextLeaf ){ // all the keys of this leaf are smaller
+            it->leaf = n->nextLeaf;
+            it->position = 0u;
+            isOperationOk = true;
+        }
+        else{ // all the keys of the tree are smaller
+            it->leaf = HLL_NULL;
+            it->position = 0u;
+        }
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_nextIt(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    bool isNotLastElement = false;
+    heaplessBTreeNode* n = ( HLL_NULL == it->leaf ) ? NULL_PTR : btreeNodeAt(t, it->leaf);
+
+    if( NULL_PTR == n ){ //empty tree or iterator not initialized
+        isNotLastElement = false;
+    }
+    else if( it->position + 1u < n->count ){
+        it->position++;
+        isNotLastElement = true;
+    }
+    else if( HLL_NULL != n->nextLeaf ){
+        it->leaf = n->nextLeaf;
+        it->position = 0u;
+        isNotLastElement = true;
+    }
+    return isNotLastElement;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBTree_previousIt(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    bool isNotFirstElement = false;
+    heaplessBTreeNode* n = ( HLL_NULL == it->leaf ) ? NULL_PTR : btreeNodeAt(t, it->leaf);
+
+    if( NULL_PTR == n ){ //empty tree or iterator not initialized
+        isNotFirstElement = false;
+    }
+    else if( it->position > 0u ){
+        it->position--;
+        isNotFirstElement = true;
+    }
+    else if( HLL_NULL != n->previousLeaf ){
+        it->leaf = n->previousLeaf;
+        it->position = (uint16_t)( btreeNodeAt(t, it->leaf)->count - 1u );
+        isNotFirstElement = true;
+    }
+    return isNotFirstElement;
+}
+
+// --------------------------------------------------------------------
+HLL_API tBTreeKey heaplessBTree_getItKey(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    return HLL_NULL == it->leaf ? (tBTreeKey)~0 : btreeNodeAt(t, it->leaf)->keys[it->position];
+}
+
+// --------------------------------------------------------------------
+HLL_API tListData heaplessBTree_getItData(heaplessBTree* t, heaplessBTreeIt* it)
+{
+    return HLL_NULL == it->leaf ? (tListData)~0 : btreeNodeAt(t, it->leaf)->values[it->position];
+}
@@ -0,0 +1,234 @@
+/**
+ * @file heaplessBlockingQueue.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief blocking queue over heaplessList implementation (linux only).
+ * The number of items and free nodes are counters taken with CAS, so nobody goes to
+ * the kernel while there is something to pop or space to append. The threads only sleep
+ * (futex) when the counter they need is zero, and each counter increment wakes at most one of them.
+ * The list itself is protected by a futex mutex that is a single CAS when nobody else holds it
+ * @version 0.1
+ */
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#include "heaplessBlockingQueue.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+/**
+ * @brief sleep while the word has the expected value
+ *
+ * @param timeout relative timeout, NULL waits forever
+ */
+inline static void blockingFutexWait(_Atomic uint32_t* word, uint32_t expected, const struct timespec* timeout)
+{
+    (void)syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+/**
+ * @brief wake up to n threads sleeping on the word
+ */
+inline static void blockingFutexWake(_Atomic uint32_t* word, uint32_t n)
+{
+    (void)syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+/**
+ * @brief monotonic time in milliseconds (same clock of the futex timeout)
+ */
+inline static uint64_t blockingNowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+/**
+ * @brief mutex with the 3 states of "Futexes Are Tricky" (Drepper)
+ */
+static void blockingLockList(heaplessBlockingQueue* bq)
+{
+    uint32_t c = 0u;
+
+    if( !atomic_compare_exchange_strong_explicit( &(bq->lock), &c, 1u, memory_order_acquire, memory_order_relaxed ) ){
+        if( 2u != c ){
+            c = atomic_exchange_explicit( &(bq->lock), 2u, memory_order_acquire );
+        }
+        while( 0u != c ){
+            blockingFutexWait( &(bq->lock), 2u, NULL_PTR );
+            c = atomic_exchange_explicit( &(bq->lock), 2u, memory_order_acquire );
+        }
+    }
+}
+
+static void blockingUnlockList(heaplessBlockingQueue* bq)
+{
+    if( 1u != atomic_fetch_sub_explicit( &(bq->lock), 1u, memory_order_release ) ){
+        atomic_store_explicit( &(bq->lock), 0u, memory_order_release );
+        blockingFutexWake( &(bq->lock), 1u );
+    }
+}
+
+/**
+ * @brief take one unit of the counter, sleeping while it is zero
+ *
+ * @param counter items or spaces
+ * @param waiters number of threads sleeping on the counter
+ * @param timeoutMs maximum time waiting
+ * @return true means one unit was taken
+ */
+static bool blockingTakeToken(_Atomic uint32_t* counter, _Atomic uint32_t* waiters, uint32_t timeoutMs)
+{
+    uint32_t c;
+    uint64_t deadline = 0u;
+    uint64_t now;
+    struct timespec timeout;
+
+    if( 0u != timeoutMs && HLL_WAIT_FOREVER != timeoutMs ){
+        deadline = blockingNowMs() + timeoutMs;
+    }
+
+    for( ;; ){
+        // fast path, no system call while the counter is not zero
+        c = atomic_load_explicit( counter, memory_order_relaxed );
+        while( 0u != c ){
+            if( atomic_compare_exchange_weak_explicit( counter, &c, c - 1u, memory_order_acquire, memory_order_relaxed ) ){
+                return true;
+            }
+        }
+
+        if( 0u == timeoutMs ){
+            return false;
+        }
+
+        // the kernel checks the counter again before sleeping, so a blockingGiveToken in between is not lost
+        atomic_fetch_add_explicit( waiters, 1u, memory_order_seq_cst );
+        if( HLL_WAIT_FOREVER == timeoutMs ){
+            blockingFutexWait( counter, 0u, NULL_PTR );
+        }
+        else{
+            now = blockingNowMs();
+            if( now >= deadline ){
+                atomic_fetch_sub_explicit( waiters, 1u, memory_order_relaxed );
+                return false;
+            }
+            timeout.tv_sec = (time_t)( (deadline - now) / 1000u );
+            timeout.tv_nsec = (long)( ((deadline - now) % 1000u) * 1000000u );
+            blockingFutexWait( counter, 0u, &timeout );
+        }
+        atomic_fetch_sub_explicit( waiters, 1u, memory_order_relaxed );
+    }
+}
+
+/**
+ * @brief give one unit back to the counter, waking one sleeping thread if there is any
+ */
+static void blockingGiveToken(_Atomic uint32_t* counter, _Atomic uint32_t* waiters)
+{
+    atomic_fetch_add_explicit( counter, 1u, memory_order_seq_cst );
+    if( 0u != atomic_load_explicit( waiters, memory_order_seq_cst ) ){
+        blockingFutexWake( counter, 1u );
+    }
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessBlockingQueue_init(heaplessBlockingQueue* bq, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize)
+{
+    heaplessList_init( &(bq->list), ringBufferArray, heapArray, maxSize );
+
+    // free nodes of the init, the nodes attached later are given by heaplessBlockingQueue_addSegment
+    atomic_init( &(bq->items), 0u );
+    atomic_init( &(bq->spaces), heaplessList_capacity( &(bq->list) ) - heaplessList_size( &(bq->list) ) );
+    atomic_init( &(bq->itemWaiters), 0u );
+    atomic_init( &(bq->spaceWaiters), 0u );
+    atomic_init( &(bq->lock), 0u );
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBlockingQueue_appendWait(heaplessBlockingQueue* bq, tListData data, uint32_t timeoutMs)
+{
+    bool wasOperationOk = false;
+
+    if( blockingTakeToken( &(bq->spaces), &(bq->spaceWaiters), timeoutMs ) ){
+        blockingLockList(bq);
+        wasOperationOk = heaplessList_append( &(bq->list), data );
+        blockingUnlockList(bq);
+        if( wasOperationOk ){
+            blockingGiveToken( &(bq->items), &(bq->itemWaiters) );
+        }
+        else{
+            blockingGiveToken( &(bq->spaces), &(bq->spaceWaiters) ); // the node is still reserved (HLL_EPOCH_READERS)
+        }
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBlockingQueue_popWait(heaplessBlockingQueue* bq, tListData* output, uint32_t timeoutMs)
+{
+    bool isQueueNotEmpty = false;
+
+    if( blockingTakeToken( &(bq->items), &(bq->itemWaiters), timeoutMs ) ){
+        blockingLockList(bq);
+        isQueueNotEmpty = heaplessList_pop( &(bq->list), output );
+        blockingUnlockList(bq);
+        blockingGiveToken( &(bq->spaces), &(bq->spaceWaiters) );
+    }
+    return isQueueNotEmpty;
+}
+
+#ifdef HLL_SEGMENTED
+// --------------------------------------------------------------------
+HLL_API bool heaplessBlockingQueue_addSegment(heaplessBlockingQueue* bq, heaplessListNode* nodes, tIndex count)
+{
+    bool wasOperationOk;
+    tIndex i;
+
+    blockingLockList(bq);
+    wasOperationOk = heaplessList_addSegment( &(bq->list), nodes, count );
+    blockingUnlockList(bq);
+    for( i = 0; wasOperationOk && i < count; i++ ){
+        blockingGiveToken( &(bq->spaces), &(bq->spaceWaiters) );
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessBlockingQueue_releaseSegment(heaplessBlockingQueue* bq, heaplessListNode* nodes)
+{
+    bool wasOperationOk = false;
+    bool hasSpaces = false;
+    tIndex count = 0u;
+    uint32_t c;
+    tIndex s;
+    tIndex i;
+
+    blockingLockList(bq);
+    for( s = 1u; s < HLL_MAX_SEGMENTS; s++ ){
+        if( nodes == bq->list.segments[s].nodes ){
+            count = bq->list.segments[s].length;
+        }
+    }
+    // the free nodes of the segment stop being spaces before it is released
+    c = atomic_load_explicit( &(bq->spaces), memory_order_relaxed );
+    while( 0u != count && !hasSpaces && c >= count ){
+        hasSpaces = atomic_compare_exchange_weak_explicit( &(bq->spaces), &c, c - count, memory_order_acquire, memory_order_relaxed );
+    }
+    if( hasSpaces ){
+        wasOperationOk = heaplessList_releaseSegment( &(bq->list), nodes );
+    }
+    blockingUnlockList(bq);
+    for( i = 0; hasSpaces && !wasOperationOk && i < count; i++ ){
+        blockingGiveToken( &(bq->spaces), &(bq->spaceWaiters) ); // some node of the segment is in use
+    }
+    return wasOperationOk;
+}
+#endif
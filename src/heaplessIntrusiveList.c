@@ -0,0 +1,215 @@
+/**
+ * @file heaplessIntrusiveList.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief intrusive list without heap implementation.
+ * Same algorithm of heaplessLinkedList, but the links are found inside the user
+ * records with the record size and the offset of the link
+ * @version 0.1
+ */
+
+#include "heaplessIntrusiveList.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+inline static void* intrusiveRecordAt(heaplessIntrusiveList* il, tIndex i)
+{
+    return il->records + (size_t)i * il->recordSize;
+}
+
+inline static heaplessListLink* intrusiveLinkAt(heaplessIntrusiveList* il, tIndex i)
+{
+    return (heaplessListLink*)( il->records + (size_t)i * il->recordSize + il->linkOffset );
+}
+
+/**
+ * @brief position of the record in the array, HLL_NULL if it is not one of the records
+ */
+inline static tIndex intrusiveRecordToIndex(heaplessIntrusiveList* il, void* record)
+{
+    tIndex i = HLL_NULL;
+    size_t offset;
+
+    if( (uint8_t*)record >= il->records ){
+        offset = (size_t)( (uint8_t*)record - il->records );
+        if( 0u == offset % il->recordSize && offset / il->recordSize < il->cMaxLength ){
+            i = (tIndex)( offset / il->recordSize );
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief remove the record from the chain and give it back to the allocationTable
+ */
+inline static bool intrusiveUnlinkRecord(heaplessIntrusiveList* il, tIndex i)
+{
+    heaplessListLink* link = intrusiveLinkAt(il, i);
+
+    if( HLL_NULL == link->previousNode )
+        il->firstNodeIndex = link->nextNode;
+    else
+        intrusiveLinkAt(il, link->previousNode)->nextNode = link->nextNode;
+
+    if( HLL_NULL == link->nextNode )
+        il->lastNodeIndex = link->previousNode;
+    else
+        intrusiveLinkAt(il, link->nextNode)->previousNode = link->previousNode;
+
+    link->previousNode = i; // free mark, a record in the list never points to itself
+    return ringBuffer_addData( &(il->allocationTable), i ); // free
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessIntrusiveList_init(heaplessIntrusiveList* il, tIndex* ringBufferArray, void* recordArray,
+                                        size_t recordSize, size_t linkOffset, tIndex maxSize)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == il || NULL_PTR == ringBufferArray || NULL_PTR == recordArray ||
+        0u == maxSize || linkOffset + sizeof(heaplessListLink) > recordSize ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    il->records = (uint8_t*)recordArray;
+    il->recordSize = recordSize;
+    il->linkOffset = linkOffset;
+    il->cMaxLength = maxSize;
+    il->firstNodeIndex = HLL_NULL;
+    il->lastNodeIndex = HLL_NULL;
+    ringBuffer_init( &(il->allocationTable), ringBufferArray, maxSize );
+
+    // add the list of free records in the ringBuffer
+    for( i = 0; i < maxSize; i++ ){
+        intrusiveLinkAt(il, i)->previousNode = i;
+        ringBuffer_addData( &(il->allocationTable), i );
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API void* heaplessIntrusiveList_append(heaplessIntrusiveList* il)
+{
+    void* record = NULL_PTR;
+    heaplessListLink* link;
+    tIndex i = ringBuffer_popData( &(il->allocationTable) ); // malloc
+
+    if( HLL_NULL != i ){
+        link = intrusiveLinkAt(il, i);
+        link->previousNode = il->lastNodeIndex;
+        link->nextNode = HLL_NULL;
+        if( HLL_NULL == il->lastNodeIndex ) // very first record case
+            il->firstNodeIndex = i;
+        else
+            intrusiveLinkAt(il, il->lastNodeIndex)->nextNode = i;
+        il->lastNodeIndex = i;
+        record = intrusiveRecordAt(il, i);
+    }
+    return record;
+}
+
+// --------------------------------------------------------------------
+HLL_API void* heaplessIntrusiveList_getFirst(heaplessIntrusiveList* il)
+{
+    return heaplessIntrusiveList_initIt(il);
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_removeFirst(heaplessIntrusiveList* il)
+{
+    bool isOperationOk = false;
+
+    if( HLL_NULL != il->firstNodeIndex ){
+        isOperationOk = intrusiveUnlinkRecord(il, il->firstNodeIndex);
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_removeLast(heaplessIntrusiveList* il)
+{
+    bool isOperationOk = false;
+
+    if( HLL_NULL != il->lastNodeIndex ){
+        isOperationOk = intrusiveUnlinkRecord(il, il->lastNodeIndex);
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_remove(heaplessIntrusiveList* il, void* record)
+{
+    bool isOperationOk = false;
+    tIndex i = intrusiveRecordToIndex(il, record);
+
+    if( HLL_NULL != i && i != intrusiveLinkAt(il, i)->previousNode ){ // not free
+        isOperationOk = intrusiveUnlinkRecord(il, i);
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API void* heaplessIntrusiveList_initIt(heaplessIntrusiveList* il)
+{
+    return ( HLL_NULL == il->firstNodeIndex ) ? NULL_PTR : intrusiveRecordAt(il, il->firstNodeIndex);
+}
+
+// --------------------------------------------------------------------
+HLL_API void* heaplessIntrusiveList_initItEnd(heaplessIntrusiveList* il)
+{
+    return ( HLL_NULL == il->lastNodeIndex ) ? NULL_PTR : intrusiveRecordAt(il, il->lastNodeIndex);
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_nextIt(heaplessIntrusiveList* il, void** record)
+{
+    bool isNotLastElement = false;
+    tIndex nextNodeIndex;
+
+    if( NULL_PTR != *record ){
+        nextNodeIndex = ( (heaplessListLink*)( (uint8_t*)*record + il->linkOffset ) )->nextNode;
+        if( HLL_NULL != nextNodeIndex ){
+            *record = intrusiveRecordAt(il, nextNodeIndex);
+            isNotLastElement = true;
+        }
+    }
+    return isNotLastElement;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_previousIt(heaplessIntrusiveList* il, void** record)
+{
+    bool isNotFirstElement = false;
+    tIndex previousNodeIndex;
+
+    if( NULL_PTR != *record ){
+        previousNodeIndex = ( (heaplessListLink*)( (uint8_t*)*record + il->linkOffset ) )->previousNode;
+        if( HLL_NULL != previousNodeIndex ){
+            *record = intrusiveRecordAt(il, previousNodeIndex);
+            isNotFirstElement = true;
+        }
+    }
+    return isNotFirstElement;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessIntrusiveList_removeAndNextIt(heaplessIntrusiveList* il, void** record)
+{
+    bool isOperationOk = false;
+    void* next = *record;
+
+    if( NULL_PTR != *record ){
+        if( !heaplessIntrusiveList_nextIt(il, &next) ){
+            next = NULL_PTR; // it was the last record
+        }
+        isOperationOk = heaplessIntrusiveList_remove(il, *record);
+        *record = next;
+    }
+    return isOperationOk;
+}
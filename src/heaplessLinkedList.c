@@ -7,20 +7,231 @@
 
 #include "heaplessLinkedList.h"
 
+#ifdef HLL_EPOCH_READERS
+// the readers do not take any lock, so the links are published with release stores and
+// read only once with acquire loads (a node is always written before it is linked)
+#define HLL_LINK_STORE(link, value) atomic_store_explicit( &(link), (value), memory_order_release )
+#define HLL_LINK_LOAD(link) atomic_load_explicit( &(link), memory_order_acquire )
+#else
+#define HLL_LINK_STORE(link, value) ( (link) = (value) )
+#define HLL_LINK_LOAD(link) (link)
+#endif
+
 /*****************************************
  ********* private functions *************
  *****************************************/
-inline static tIndex pointerToIndex(heaplessList* l, heaplessListNode* n)
+/**
+ * @brief take a free index from the allocationTable, the oldest or the newest one
+ */
+inline static tIndex listPopFreeIndex(heaplessList* l)
+{
+#ifdef HLL_LIFO_ALLOCATION
+    return ringBuffer_popLastData( &(l->allocationTable) );
+#else
+    return ringBuffer_popData( &(l->allocationTable) );
+#endif
+}
+
+#ifdef HLL_PARALLEL
+/**
+ * @brief keep the bitmap of the nodes in the list, used by heaplessListParallel
+ */
+inline static void listSetLive(heaplessList* l, tIndex i, bool isLive)
+{
+    if( NULL_PTR != l->liveBitmap ){
+        if( isLive )
+            l->liveBitmap[i >> 5] |= (uint32_t)1u << (i & 31u);
+        else
+            l->liveBitmap[i >> 5] &= ~( (uint32_t)1u << (i & 31u) );
+    }
+}
+#endif
+
+/**
+ * @brief count the elements added and removed, and check the watermarks
+ */
+inline static void listUpdateLength(heaplessList* l, bool isAdded)
+{
+    if( isAdded ) l->length++;
+    else l->length--;
+#ifdef HLL_WATERMARKS
+    if( NULL_PTR != l->watermarkCallback ){
+        if( !l->isAboveWatermark && l->length >= l->highWatermark ){
+            l->isAboveWatermark = true;
+            l->watermarkCallback( true, l->length, l->watermarkContext );
+        }
+        else if( l->isAboveWatermark && l->length <= l->lowWatermark ){
+            l->isAboveWatermark = false;
+            l->watermarkCallback( false, l->length, l->watermarkContext );
+        }
+    }
+#endif
+}
+
+#ifdef HLL_SEGMENTED
+/**
+ * @brief get the node from the index, the higher bits are the segment
+ * and the lower bits are the position inside the segment
+ */
+inline static heaplessListNode* listNodeAt(heaplessList* l, tIndex i)
+{
+    return &( l->segments[i >> HLL_SEGMENT_OFFSET_BITS].nodes[i & HLL_SEGMENT_OFFSET_MASK] );
+}
+
+inline static tIndex listPointerToIndex(heaplessList* l, heaplessListNode* n)
+{
+    tIndex s;
+    tIndex i = HLL_NULL;
+
+    // the number of segments is small and fixed, so it is still O(1)
+    for( s = 0; s < HLL_MAX_SEGMENTS; s++ ){
+        if( n >= l->segments[s].nodes && n < l->segments[s].nodes + l->segments[s].length ){
+            i = (tIndex)( (s << HLL_SEGMENT_OFFSET_BITS) | (tIndex)(n - l->segments[s].nodes) );
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief get a free node, first from the allocationTable and then from the attached segments
+ */
+inline static tIndex listAllocNode(heaplessList* l)
+{
+    tIndex s;
+    tIndex i = listPopFreeIndex(l);
+
+    for( s = 1u; HLL_NULL == i && s < HLL_MAX_SEGMENTS; s++ ){
+        if( 0u != l->segments[s].freeCount ){
+            i = l->segments[s].freeHead;
+            l->segments[s].freeHead = listNodeAt(l, i)->nextNode;
+            l->segments[s].freeCount--;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief give the node back to where it came from. The nodes of the attached
+ * segments are kept in a free list of the segment, so it knows when it is empty
+ */
+inline static bool listFreeNode(heaplessList* l, tIndex i)
+{
+    bool wasOperationOk = true;
+    heaplessListSegment* segment = &( l->segments[i >> HLL_SEGMENT_OFFSET_BITS] );
+
+    listUpdateLength(l, false);
+#ifdef HLL_STABLE_HANDLES
+    listNodeAt(l, i)->generation++; // the handles of this element are stale now
+#endif
+    if( segment == &( l->segments[0] ) ){
+        wasOperationOk = ringBuffer_addData( &(l->allocationTable), i );
+    }
+    else{
+        listNodeAt(l, i)->nextNode = segment->freeHead;
+        segment->freeHead = i;
+        segment->freeCount++;
+    }
+    return wasOperationOk;
+}
+#else
+inline static heaplessListNode* listNodeAt(heaplessList* l, tIndex i)
+{
+    return &( l->linkedList[i] );
+}
+
+inline static tIndex listPointerToIndex(heaplessList* l, heaplessListNode* n)
 {
     return (tIndex) (n - l->linkedList) ;
 }
 
+#ifdef HLL_EPOCH_READERS
+/**
+ * @brief get a free node, the removed nodes are used only after the readers left them
+ */
+inline static tIndex listAllocNode(heaplessList* l)
+{
+    tIndex i = HLL_NULL;
+
+    if( l->allocationTable.lenght == l->retiredCount ){
+        (void)heaplessList_reclaim(l);
+    }
+    if( l->allocationTable.lenght > l->retiredCount ){
+        i = listPopFreeIndex(l);
+    }
+    return i;
+}
+#else
+inline static tIndex listAllocNode(heaplessList* l)
+{
+    return listPopFreeIndex(l);
+}
+#endif
+
+/**
+ * @brief give the node back to the allocationTable. With HLL_EPOCH_READERS it stays
+ * in the end of the table (retired) and it is not reused until heaplessList_reclaim
+ */
+inline static bool listFreeNode(heaplessList* l, tIndex i)
+{
+    bool wasOperationOk;
+
+    listUpdateLength(l, false);
+#ifdef HLL_PARALLEL
+    listSetLive(l, i, false);
+#endif
+#ifdef HLL_STABLE_HANDLES
+    listNodeAt(l, i)->generation++; // the handles of this element are stale now
+#endif
+    wasOperationOk = ringBuffer_addData( &(l->allocationTable), i );
+#ifdef HLL_EPOCH_READERS
+    l->retiredCount++;
+#endif
+    return wasOperationOk;
+}
+#endif
+
+#ifdef HLL_STABLE_HANDLES
+/**
+ * @brief check if the index is a node of the list memory (handles may come from anywhere)
+ */
+inline static bool listIsIndexInList(heaplessList* l, tIndex i)
+{
+#if defined(HLL_SEGMENTED) && defined(HLL_SENTINEL_NODE)
+    return (i & HLL_SEGMENT_OFFSET_MASK) < l->segments[i >> HLL_SEGMENT_OFFSET_BITS].length && i != l->sentinelIndex;
+#elif defined(HLL_SEGMENTED)
+    return (i & HLL_SEGMENT_OFFSET_MASK) < l->segments[i >> HLL_SEGMENT_OFFSET_BITS].length;
+#elif defined(HLL_SENTINEL_NODE)
+    return i < l->sentinelIndex;
+#else
+    return i < l->cMaxLength;
+#endif
+}
+#endif
+
+#ifdef HLL_SENTINEL_NODE
+/**
+ * @brief remove the node from the circle, there are no special cases
+ * because the sentinel is always the neighbour of the first and last nodes
+ * 
+ * @param l pointer to the list
+ * @param i index of the node to be removed
+ */
+inline static void listUnlinkNode(heaplessList* l, tIndex i)
+{
+    tIndex previousNodeIndex = listNodeAt(l, i)->previousNode;
+    tIndex nextNodeIndex = listNodeAt(l, i)->nextNode;
+    HLL_LINK_STORE( listNodeAt(l, previousNodeIndex)->nextNode, nextNodeIndex );
+    HLL_LINK_STORE( listNodeAt(l, nextNodeIndex)->previousNode, previousNodeIndex );
+}
+#endif
+
 /*****************************************
  ********* public functions **************
  *****************************************/
 
 // --------------------------------------------------------------------
-void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize)
+HLL_API void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNode* heapArray, tIndex maxSize)
 {
     tIndex i;
 
@@ -33,47 +244,157 @@ void heaplessList_init(heaplessList* l, tIndex* ringBufferArray, heaplessListNod
 
     l->linkedList = heapArray; 
     l->cMaxLength = maxSize;
+    l->length = 0u;
+#ifdef HLL_WATERMARKS
+    l->watermarkCallback = NULL_PTR;
+    l->isAboveWatermark = false;
+#endif
+#ifdef HLL_SEGMENTED
+    // the nodes given in the init are the segment 0, the others are attached later
+    if( maxSize > HLL_SEGMENT_OFFSET_MASK ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+    for( i = 0; i < HLL_MAX_SEGMENTS; i++ ){
+        l->segments[i].nodes = NULL_PTR;
+        l->segments[i].length = 0u;
+        l->segments[i].freeCount = 0u;
+        l->segments[i].freeHead = HLL_NULL;
+    }
+    l->segments[0].nodes = heapArray;
+    l->segments[0].length = maxSize;
+#endif
+    ringBuffer_init( &(l->allocationTable), ringBufferArray, maxSize );
+#ifdef HLL_SENTINEL_NODE
+    // the last node is reserved, an empty list is the sentinel pointing to itself
+    if( maxSize < 2u ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+    l->sentinelIndex = maxSize - 1u;
+    listNodeAt(l, l->sentinelIndex)->nextNode = l->sentinelIndex;
+    listNodeAt(l, l->sentinelIndex)->previousNode = l->sentinelIndex;
+    maxSize--;
+#else
     l->firstNodeIndex = HLL_NULL;
     l->lastNodeIndex = HLL_NULL;
-    ringBuffer_init( &(l->allocationTable), ringBufferArray, maxSize );
+#endif
+#ifdef HLL_PARALLEL
+    l->liveBitmap = NULL_PTR;
+#endif
+#ifdef HLL_EPOCH_READERS
+    l->retiredCount = 0u;
+    l->graceCount = 0u;
+    atomic_init( &(l->globalEpoch), 1u );
+    for( i = 0; i < HLL_MAX_READERS; i++ ){
+        atomic_init( &(l->readers[i].epoch), 0u );
+    }
+#endif
+
+    l->capacity = maxSize;
 
     // add the list of free spaces in the ringBuffer
     for( i = 0; i < maxSize; i++ ){
+#ifdef HLL_STABLE_HANDLES
+        listNodeAt(l, i)->generation++; // handles of a previous use of the array never resolve
+#endif
         ringBuffer_addData( &(l->allocationTable), i );
     }
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_append(heaplessList* l, tListData data)
+HLL_API bool heaplessList_append(heaplessList* l, tListData data)
 {
-    tIndex i;
+    tIndex i = HLL_NULL;
     bool wasOperationOk = false;
 
-    i = ringBuffer_popData( &(l->allocationTable) ); // malloc
+    // a full list fails here, without looking for a node in the allocationTable and the segments
+    if( l->length < l->capacity ){
+        i = listAllocNode(l); // malloc
+    }
+#ifdef HLL_PARALLEL
+    if( HLL_NULL != i ) listSetLive(l, i, true);
+#endif
+#ifdef HLL_SENTINEL_NODE
     if( HLL_NULL != i ){
+        tIndex s = l->sentinelIndex;
+        tIndex last = listNodeAt(l, s)->previousNode;
+        listNodeAt(l, i)->data = data;
+        listNodeAt(l, i)->previousNode = last;
+        listNodeAt(l, i)->nextNode = s;
+        HLL_LINK_STORE( listNodeAt(l, last)->nextNode, i );
+        HLL_LINK_STORE( listNodeAt(l, s)->previousNode, i );
+        wasOperationOk = true;
+    }
+#else
+    if( HLL_NULL != i ){
+        // the node is written before it is linked, so a reader never sees it half done
+        listNodeAt(l, i)->data = data;
+        listNodeAt(l, i)->nextNode = HLL_NULL;
         // very first element case, first = last
         if( HLL_NULL == l->firstNodeIndex){
-            l->firstNodeIndex = i;
-            l->lastNodeIndex = i;
-            l->linkedList[i].nextNode = HLL_NULL;
-            l->linkedList[i].previousNode = HLL_NULL;
-            l->linkedList[i].data = data;
+            listNodeAt(l, i)->previousNode = HLL_NULL;
+            HLL_LINK_STORE( l->lastNodeIndex, i );
+            HLL_LINK_STORE( l->firstNodeIndex, i );
         }
         // other elements case
         else{
-            l->linkedList[i].previousNode = l->lastNodeIndex;
-            l->linkedList[i].nextNode = HLL_NULL;
-            l->linkedList[l->lastNodeIndex].nextNode = i;
-            l->lastNodeIndex = i;
-            l->linkedList[i].data = data;
+            listNodeAt(l, i)->previousNode = l->lastNodeIndex;
+            HLL_LINK_STORE( listNodeAt(l, l->lastNodeIndex)->nextNode, i );
+            HLL_LINK_STORE( l->lastNodeIndex, i );
         }
         wasOperationOk = true;
     }
+#endif
+    if( wasOperationOk ){
+        listUpdateLength(l, true);
+    }
     return wasOperationOk;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_pop(heaplessList* l, tListData* output)
+HLL_API tIndex heaplessList_size(heaplessList* l)
+{
+    return l->length;
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex heaplessList_capacity(heaplessList* l)
+{
+    return l->capacity;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_isFull(heaplessList* l)
+{
+    return l->length >= l->capacity;
+}
+
+#ifdef HLL_WATERMARKS
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_setWatermarks(heaplessList* l, tIndex high, tIndex low,
+                                        heaplessList_watermarkFunction callback, void* context)
+{
+    //check inputs
+    if( NULL_PTR != callback && low >= high ){
+        HLL_ASSERT(false,1);
+        return false;
+    }
+
+    l->highWatermark = high;
+    l->lowWatermark = low;
+    l->watermarkContext = context;
+    l->watermarkCallback = callback;
+    l->isAboveWatermark = ( NULL_PTR != callback && l->length >= high );
+    if( l->isAboveWatermark ){
+        callback( true, l->length, context );
+    }
+    return true;
+}
+#endif
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_pop(heaplessList* l, tListData* output)
 {
     bool isListNotEmpty = false;
 
@@ -83,137 +404,196 @@ bool heaplessList_pop(heaplessList* l, tListData* output)
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_getFirst(heaplessList* l, tListData* output)
+HLL_API bool heaplessList_getFirst(heaplessList* l, tListData* output)
 {
     bool isListNotEmpty = false;
 
+#ifdef HLL_SENTINEL_NODE
+    tIndex first = listNodeAt(l, l->sentinelIndex)->nextNode;
+    if( l->sentinelIndex != first ){
+        *output = listNodeAt(l, first)->data;
+        isListNotEmpty = true;
+    }
+#else
     if( HLL_NULL != l->firstNodeIndex ){
-        *output = l->linkedList[l->firstNodeIndex].data;
+        *output = listNodeAt(l, l->firstNodeIndex)->data;
         isListNotEmpty = true;
     }
+#endif
     return isListNotEmpty;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_removeFirst(heaplessList* l)
+HLL_API bool heaplessList_removeFirst(heaplessList* l)
 {
     bool isOperationOk = false;
+#ifdef HLL_SENTINEL_NODE
+    tIndex first = listNodeAt(l, l->sentinelIndex)->nextNode;
+
+    if( l->sentinelIndex != first ){
+        listUnlinkNode(l, first);
+        isOperationOk = listFreeNode(l, first); // free
+    }
+#else
     tIndex nodeIndex;
+    tIndex removedNodeIndex;
 
     if( HLL_NULL != l->firstNodeIndex ){
-        isOperationOk = ringBuffer_addData( &(l->allocationTable), l->firstNodeIndex ); // free
-        if( isOperationOk ){ // means the list was not empty
-            if( l->lastNodeIndex == l->firstNodeIndex ){ // means it the last element to be removed
-                l->lastNodeIndex = HLL_NULL;
-                l->firstNodeIndex = HLL_NULL;
-            }
-            else{
-                nodeIndex = l->linkedList[l->firstNodeIndex].nextNode;
-                l->linkedList[nodeIndex].previousNode = HLL_NULL;
-                l->firstNodeIndex = nodeIndex;
-            }
+        removedNodeIndex = l->firstNodeIndex;
+        if( l->lastNodeIndex == l->firstNodeIndex ){ // means it the last element to be removed
+            HLL_LINK_STORE( l->lastNodeIndex, HLL_NULL );
+            HLL_LINK_STORE( l->firstNodeIndex, HLL_NULL );
         }
+        else{
+            nodeIndex = listNodeAt(l, l->firstNodeIndex)->nextNode;
+            HLL_LINK_STORE( listNodeAt(l, nodeIndex)->previousNode, HLL_NULL );
+            HLL_LINK_STORE( l->firstNodeIndex, nodeIndex );
+        }
+        // free only after reading the links, the free node may be reused to keep the free nodes
+        isOperationOk = listFreeNode(l, removedNodeIndex); // free
     }
+#endif
     return isOperationOk;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_removeLast(heaplessList* l)
+HLL_API bool heaplessList_removeLast(heaplessList* l)
 {
     bool isOperationOk = false;
+#ifdef HLL_SENTINEL_NODE
+    tIndex last = listNodeAt(l, l->sentinelIndex)->previousNode;
+
+    if( l->sentinelIndex != last ){
+        listUnlinkNode(l, last);
+        isOperationOk = listFreeNode(l, last); // free
+    }
+#else
     tIndex nodeIndex;
+    tIndex removedNodeIndex;
 
     if( HLL_NULL != l->lastNodeIndex ){
-        isOperationOk = ringBuffer_addData( &(l->allocationTable), l->lastNodeIndex ); // free
-        if( isOperationOk ){ // means the list was not empty
-            if( l->lastNodeIndex == l->firstNodeIndex ){ // means is the last element to be removed
-                l->lastNodeIndex = HLL_NULL;
-                l->firstNodeIndex = HLL_NULL;
-            }
-            else{
-                nodeIndex = l->linkedList[l->lastNodeIndex].previousNode;
-                l->linkedList[nodeIndex].nextNode = HLL_NULL;
-                l->lastNodeIndex = nodeIndex;
-            }
+        removedNodeIndex = l->lastNodeIndex;
+        if( l->lastNodeIndex == l->firstNodeIndex ){ // means is the last element to be removed
+            HLL_LINK_STORE( l->lastNodeIndex, HLL_NULL );
+            HLL_LINK_STORE( l->firstNodeIndex, HLL_NULL );
+        }
+        else{
+            nodeIndex = listNodeAt(l, l->lastNodeIndex)->previousNode;
+            HLL_LINK_STORE( listNodeAt(l, nodeIndex)->nextNode, HLL_NULL );
+            HLL_LINK_STORE( l->lastNodeIndex, nodeIndex );
         }
+        isOperationOk = listFreeNode(l, removedNodeIndex); // free
     }
+#endif
     return isOperationOk;
 }
 
 // --------------------------------------------------------------------
-heaplessListNode* heaplessList_initIt(heaplessList* l)
+HLL_API heaplessListNode* heaplessList_initIt(heaplessList* l)
 {
     heaplessListNode* it;
 
-    if( HLL_NULL == l->firstNodeIndex )
+#ifdef HLL_SENTINEL_NODE
+    tIndex first = HLL_LINK_LOAD( listNodeAt(l, l->sentinelIndex)->nextNode );
+    it = ( l->sentinelIndex == first ) ? NULL_PTR : listNodeAt(l, first);
+#else
+    tIndex first = HLL_LINK_LOAD( l->firstNodeIndex );
+    if( HLL_NULL == first )
         it = NULL_PTR;
     else
-        it = &( l->linkedList[l->firstNodeIndex] );
+        it = listNodeAt(l, first);
+#endif
     return it;
 }
 
 // --------------------------------------------------------------------
-heaplessListNode* heaplessList_initItEnd(heaplessList* l)
+HLL_API heaplessListNode* heaplessList_initItEnd(heaplessList* l)
 {
     heaplessListNode* it;
 
-    if( HLL_NULL == l->lastNodeIndex )
+#ifdef HLL_SENTINEL_NODE
+    tIndex last = HLL_LINK_LOAD( listNodeAt(l, l->sentinelIndex)->previousNode );
+    it = ( l->sentinelIndex == last ) ? NULL_PTR : listNodeAt(l, last);
+#else
+    tIndex last = HLL_LINK_LOAD( l->lastNodeIndex );
+    if( HLL_NULL == last )
         it = NULL_PTR;
     else
-        it = &( l->linkedList[l->lastNodeIndex] );
+        it = listNodeAt(l, last);
+#endif
     return it;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_nextIt(heaplessList* l, heaplessListNode** n)
+HLL_API bool heaplessList_nextIt(heaplessList* l, heaplessListNode** n)
 {
     bool isNotLastElement;
+    tIndex nextNodeIndex;
 
     if( NULL_PTR == *n ){
         isNotLastElement = false;
     }
-    if(HLL_NULL == (*n)->nextNode){
+#ifdef HLL_SENTINEL_NODE
+    else if(l->sentinelIndex == (nextNodeIndex = HLL_LINK_LOAD((*n)->nextNode))){
+#else
+    else if(HLL_NULL == (nextNodeIndex = HLL_LINK_LOAD((*n)->nextNode))){
+#endif
         isNotLastElement = false;
     }
     else{
-        *n = &( l->linkedList[(*n)->nextNode] );
+        *n = listNodeAt(l, nextNodeIndex);
         isNotLastElement = true;
     }
     return isNotLastElement;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_previousIt(heaplessList* l, heaplessListNode** n)
+HLL_API bool heaplessList_previousIt(heaplessList* l, heaplessListNode** n)
 {
     bool isNotFirstElement;
+    tIndex previousNodeIndex;
 
     if( NULL_PTR == *n ){
         isNotFirstElement = false;
     }
-    if(HLL_NULL == (*n)->previousNode){
+#ifdef HLL_SENTINEL_NODE
+    else if(l->sentinelIndex == (previousNodeIndex = HLL_LINK_LOAD((*n)->previousNode))){
+#else
+    else if(HLL_NULL == (previousNodeIndex = HLL_LINK_LOAD((*n)->previousNode))){
+#endif
         isNotFirstElement = false;
     }
     else{
-        *n = &( l->linkedList[(*n)->previousNode] );
+        *n = listNodeAt(l, previousNodeIndex);
         isNotFirstElement = true;
     }
     return isNotFirstElement;
 }
 
 // --------------------------------------------------------------------
-tListData heaplessList_getItData(heaplessListNode* n)
+HLL_API tListData heaplessList_getItData(heaplessListNode* n)
 {
     return NULL_PTR == n ? ~0 : n->data;
 }
 
 // --------------------------------------------------------------------
-bool heaplessList_removeAndNextIt(heaplessList* l, heaplessListNode** n)
+HLL_API bool heaplessList_removeAndNextIt(heaplessList* l, heaplessListNode** n)
 {
     bool isOperationOk = true;
 
     if( NULL_PTR == *n ){ //No elements in the list or pointer not initialized
         isOperationOk = false;
     }
+#ifdef HLL_SENTINEL_NODE
+    else{
+        // same unlink for every position, the sentinel closes the circle
+        tIndex nodeIndexinList = listPointerToIndex(l, *n);
+        tIndex nextNodeIndex = (*n)->nextNode;
+        listUnlinkNode(l, nodeIndexinList);
+        isOperationOk = listFreeNode(l, nodeIndexinList); // free
+        *n = ( l->sentinelIndex == nextNodeIndex ) ? NULL_PTR : listNodeAt(l, nextNodeIndex);
+    }
+#else
     else if(HLL_NULL == (*n)->previousNode){ // isFirstElement
         isOperationOk = heaplessList_removeFirst(l);
         *n = heaplessList_initIt(l);
@@ -224,13 +604,210 @@ bool heaplessList_removeAndNextIt(heaplessList* l, heaplessListNode** n)
     }
     else{
         // find the index to the array that stores the list, in order to free the memory
-        tIndex nodeIndexinList = pointerToIndex(l, *n);
-        isOperationOk = ringBuffer_addData( &(l->allocationTable), nodeIndexinList ); // free
-        if( isOperationOk ){
-            l->linkedList[(*n)->previousNode].nextNode = (*n)->nextNode;
-            l->linkedList[(*n)->nextNode].previousNode = (*n)->previousNode;
-            *n = &( l->linkedList[(*n)->nextNode] );
+        tIndex nodeIndexinList = listPointerToIndex(l, *n);
+        tIndex nextNodeIndex = (*n)->nextNode;
+        HLL_LINK_STORE( listNodeAt(l, (*n)->previousNode)->nextNode, nextNodeIndex );
+        HLL_LINK_STORE( listNodeAt(l, nextNodeIndex)->previousNode, (*n)->previousNode );
+        isOperationOk = listFreeNode(l, nodeIndexinList); // free
+        *n = listNodeAt(l, nextNodeIndex);
+    }
+#endif
+    return isOperationOk;
+}
+
+#ifdef HLL_PARALLEL
+// --------------------------------------------------------------------
+HLL_API void heaplessList_initLiveBitmap(heaplessList* l, uint32_t* bitmapArray)
+{
+    tIndex i;
+    heaplessListNode* it;
+
+    if( NULL_PTR == bitmapArray ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    l->liveBitmap = bitmapArray;
+    for( i = 0; i < HLL_LIVE_BITMAP_WORDS(l->cMaxLength); i++ ){
+        bitmapArray[i] = 0u;
+    }
+    // the list may be already in use
+    for( it = heaplessList_initIt(l); NULL_PTR != it; ){
+        listSetLive( l, listPointerToIndex(l, it), true );
+        if( !heaplessList_nextIt(l, &it) ) break;
+    }
+}
+#endif
+
+#ifdef HLL_EPOCH_READERS
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_readBegin(heaplessList* l, tIndex reader)
+{
+    bool isOperationOk = false;
+    uint32_t epoch;
+
+    if( reader < HLL_MAX_READERS ){
+        // publish the epoch and check it again: if the writer changed it in between, the
+        // reader could already see the nodes removed before the change, so it is published again
+        do{
+            epoch = atomic_load_explicit( &(l->globalEpoch), memory_order_seq_cst );
+            atomic_store_explicit( &(l->readers[reader].epoch), epoch, memory_order_seq_cst );
+        } while( epoch != atomic_load_explicit( &(l->globalEpoch), memory_order_seq_cst ) );
+        isOperationOk = true;
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_readEnd(heaplessList* l, tIndex reader)
+{
+    bool isOperationOk = false;
+
+    if( reader < HLL_MAX_READERS ){
+        atomic_store_explicit( &(l->readers[reader].epoch), 0u, memory_order_release );
+        isOperationOk = true;
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_reclaim(heaplessList* l)
+{
+    bool wasOperationOk = false;
+    bool isGraceOver = true;
+    uint32_t epoch;
+    uint32_t readerEpoch;
+    tIndex r;
+
+    if( 0u == l->graceCount && 0u != l->retiredCount ){
+        // new grace period for the nodes removed until now
+        l->graceCount = l->retiredCount;
+        atomic_fetch_add_explicit( &(l->globalEpoch), 1u, memory_order_seq_cst );
+    }
+
+    if( 0u != l->graceCount ){
+        // the epoch only changes again after this grace period, so comparing for equality is enough
+        epoch = atomic_load_explicit( &(l->globalEpoch), memory_order_relaxed );
+        for( r = 0; r < HLL_MAX_READERS && isGraceOver; r++ ){
+            readerEpoch = atomic_load_explicit( &(l->readers[r].epoch), memory_order_seq_cst );
+            isGraceOver = ( 0u == readerEpoch || epoch == readerEpoch );
+        }
+        if( isGraceOver ){
+            // they are the oldest retired indexes, so they are the next ones to be popped
+            l->retiredCount -= l->graceCount;
+            l->graceCount = 0u;
+            wasOperationOk = true;
         }
     }
+    return wasOperationOk;
+}
+#endif
+
+#ifdef HLL_STABLE_HANDLES
+// --------------------------------------------------------------------
+HLL_API heaplessListHandle heaplessList_getHandle(heaplessList* l, heaplessListNode* n)
+{
+    heaplessListHandle handle = { HLL_NULL, 0u };
+
+    if( NULL_PTR != n ){
+        handle.index = listPointerToIndex(l, n);
+        handle.generation = n->generation;
+    }
+    return handle;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_appendWithHandle(heaplessList* l, tListData data, heaplessListHandle* handle)
+{
+    bool wasOperationOk = heaplessList_append(l, data);
+
+    if( wasOperationOk ){
+        *handle = heaplessList_getHandle( l, heaplessList_initItEnd(l) );
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API heaplessListNode* heaplessList_resolve(heaplessList* l, heaplessListHandle handle)
+{
+    heaplessListNode* n = NULL_PTR;
+
+    // the generation changed if the element was removed, even if the node was reused
+    if( listIsIndexInList(l, handle.index) && handle.generation == listNodeAt(l, handle.index)->generation ){
+        n = listNodeAt(l, handle.index);
+    }
+    return n;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_removeByHandle(heaplessList* l, heaplessListHandle handle)
+{
+    bool isOperationOk = false;
+    heaplessListNode* n = heaplessList_resolve(l, handle);
+
+    if( NULL_PTR != n ){
+        isOperationOk = heaplessList_removeAndNextIt(l, &n);
+    }
     return isOperationOk;
 }
+#endif
+
+#ifdef HLL_SEGMENTED
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_addSegment(heaplessList* l, heaplessListNode* nodes, tIndex count)
+{
+    bool wasOperationOk = false;
+    tIndex s;
+    tIndex i;
+    heaplessListSegment* segment;
+
+    if( NULL_PTR == nodes || 0u == count || count > HLL_SEGMENT_OFFSET_MASK ){
+        HLL_ASSERT(false,1);
+        return false;
+    }
+
+    for( s = 1u; s < HLL_MAX_SEGMENTS; s++ ){
+        segment = &( l->segments[s] );
+        if( 0u == segment->length ){
+            segment->nodes = nodes;
+            segment->length = count;
+            segment->freeCount = count;
+            segment->freeHead = (tIndex)( s << HLL_SEGMENT_OFFSET_BITS );
+            l->capacity += count;
+            // all the nodes start in the free list of the segment
+            for( i = 0; i < count; i++ ){
+#ifdef HLL_STABLE_HANDLES
+                nodes[i].generation++;
+#endif
+                nodes[i].nextNode = ( i + 1u == count ) ? HLL_NULL : (tIndex)( segment->freeHead + i + 1u );
+            }
+            wasOperationOk = true;
+            break;
+        }
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessList_releaseSegment(heaplessList* l, heaplessListNode* nodes)
+{
+    bool wasOperationOk = false;
+    tIndex s;
+
+    for( s = 1u; s < HLL_MAX_SEGMENTS; s++ ){
+        if( nodes == l->segments[s].nodes ){
+            // only when none of the nodes is in the list
+            if( l->segments[s].freeCount == l->segments[s].length ){
+                l->capacity -= l->segments[s].length;
+                l->segments[s].nodes = NULL_PTR;
+                l->segments[s].length = 0u;
+                l->segments[s].freeCount = 0u;
+                l->segments[s].freeHead = HLL_NULL;
+                wasOperationOk = true;
+            }
+            break;
+        }
+    }
+    return wasOperationOk;
+}
+#endif
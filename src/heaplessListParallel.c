@@ -0,0 +1,217 @@
+/**
+ * @file heaplessListParallel.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief parallel passes over the heaplessList node array implementation.
+ * The chunks are taken one by one with an atomic counter, so a thread that finishes
+ * early takes more chunks, and each thread keeps its own partial result
+ * @version 0.1
+ */
+
+#include "heaplessListParallel.h"
+
+#ifdef HLL_PARALLEL
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+/**
+ * @brief process chunks until there is none left, the live nodes of each 32 nodes
+ * are found with count leading zeros on their bitmap word
+ *
+ * @param job pass being executed
+ */
+static void parallelRunChunks(heaplessParallelJob* job)
+{
+    heaplessList* l = job->list;
+    uint32_t words = HLL_LIVE_BITMAP_WORDS(l->cMaxLength);
+    uint32_t chunk;
+    uint32_t w;
+    uint32_t lastWord;
+    uint32_t bits;
+    uint32_t bit;
+    tIndex i;
+    tListReduce accumulator = job->identity;
+
+    while( (chunk = atomic_fetch_add_explicit( &(job->nextChunk), 1u, memory_order_relaxed )) < job->numberOfChunks ){
+        w = chunk * (HLL_PARALLEL_CHUNK / 32u);
+        lastWord = ( w + HLL_PARALLEL_CHUNK / 32u < words ) ? w + HLL_PARALLEL_CHUNK / 32u : words;
+        for( ; w < lastWord; w++ ){
+            bits = l->liveBitmap[w];
+            while( 0u != bits ){
+                bit = 31u - HLL_CLZ32(bits);
+                bits &= ~( (uint32_t)1u << bit );
+                i = (tIndex)( (w << 5) + bit );
+                if( NULL_PTR != job->forEach )
+                    job->forEach( &(l->linkedList[i].data), job->context );
+                else
+                    accumulator = job->accumulate( accumulator, l->linkedList[i].data, job->context );
+            }
+        }
+    }
+    job->partial[ atomic_fetch_add_explicit( &(job->numberOfPartials), 1u, memory_order_relaxed ) ] = accumulator;
+}
+
+/**
+ * @brief helper thread, it sleeps until there is a new pass
+ */
+static void* parallelHelper(void* arg)
+{
+    heaplessParallelPool* pool = (heaplessParallelPool*)arg;
+    heaplessParallelJob* job;
+    uint32_t lastJob = 0u; // jobNumber of the init, the first pass may start before the thread
+
+    pthread_mutex_lock( &(pool->lock) );
+    for( ;; ){
+        while( !pool->stop && lastJob == pool->jobNumber ){
+            pthread_cond_wait( &(pool->jobReady), &(pool->lock) );
+        }
+        if( pool->stop ){
+            break;
+        }
+        lastJob = pool->jobNumber;
+        job = pool->job;
+        pthread_mutex_unlock( &(pool->lock) );
+
+        parallelRunChunks(job);
+
+        pthread_mutex_lock( &(pool->lock) );
+        if( 0u == --(pool->runningThreads) ){
+            pthread_cond_signal( &(pool->jobDone) );
+        }
+    }
+    pthread_mutex_unlock( &(pool->lock) );
+    return NULL_PTR;
+}
+
+/**
+ * @brief execute the pass with the helpers, or only in the caller thread
+ * when there is no pool or the list fits in one chunk
+ */
+static void parallelRunPass(heaplessParallelPool* pool, heaplessParallelJob* job)
+{
+    job->numberOfChunks = ( job->list->cMaxLength + HLL_PARALLEL_CHUNK - 1u ) / HLL_PARALLEL_CHUNK;
+    atomic_init( &(job->nextChunk), 0u );
+    atomic_init( &(job->numberOfPartials), 0u );
+
+    if( NULL_PTR != pool && 0u != pool->numberOfThreads && job->numberOfChunks > 1u ){
+        pthread_mutex_lock( &(pool->lock) );
+        pool->job = job;
+        pool->jobNumber++;
+        pool->runningThreads = pool->numberOfThreads;
+        pthread_cond_broadcast( &(pool->jobReady) );
+        pthread_mutex_unlock( &(pool->lock) );
+
+        parallelRunChunks(job);
+
+        pthread_mutex_lock( &(pool->lock) );
+        while( 0u != pool->runningThreads ){
+            pthread_cond_wait( &(pool->jobDone), &(pool->lock) );
+        }
+        pthread_mutex_unlock( &(pool->lock) );
+    }
+    else{
+        parallelRunChunks(job); // sequential fallback
+    }
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessParallelPool_init(heaplessParallelPool* pool, tIndex numberOfThreads)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == pool || numberOfThreads > HLL_PARALLEL_MAX_THREADS ){
+        HLL_ASSERT(false,1);
+        return false;
+    }
+
+    pthread_mutex_init( &(pool->lock), NULL_PTR );
+    pthread_cond_init( &(pool->jobReady), NULL_PTR );
+    pthread_cond_init( &(pool->jobDone), NULL_PTR );
+    pool->jobNumber = 0u;
+    pool->runningThreads = 0u;
+    pool->stop = false;
+    pool->job = NULL_PTR;
+
+    for( i = 0; i < numberOfThreads; i++ ){
+        if( 0 != pthread_create( &(pool->threads[i]), NULL_PTR, parallelHelper, pool ) ){
+            break;
+        }
+    }
+    pool->numberOfThreads = i;
+    return i == numberOfThreads;
+}
+
+// --------------------------------------------------------------------
+HLL_API void heaplessParallelPool_shutdown(heaplessParallelPool* pool)
+{
+    tIndex i;
+
+    pthread_mutex_lock( &(pool->lock) );
+    pool->stop = true;
+    pthread_cond_broadcast( &(pool->jobReady) );
+    pthread_mutex_unlock( &(pool->lock) );
+
+    for( i = 0; i < pool->numberOfThreads; i++ ){
+        pthread_join( pool->threads[i], NULL_PTR );
+    }
+    pool->numberOfThreads = 0u;
+    pthread_cond_destroy( &(pool->jobDone) );
+    pthread_cond_destroy( &(pool->jobReady) );
+    pthread_mutex_destroy( &(pool->lock) );
+}
+
+// --------------------------------------------------------------------
+HLL_API void heaplessList_parallelForEach(heaplessList* l, heaplessParallelPool* pool,
+                                          heaplessList_forEachFunction forEach, void* context)
+{
+    heaplessParallelJob job;
+
+    //check inputs
+    if( NULL_PTR == l || NULL_PTR == l->liveBitmap || NULL_PTR == forEach ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    job.list = l;
+    job.forEach = forEach;
+    job.accumulate = NULL_PTR;
+    job.context = context;
+    job.identity = 0u;
+    parallelRunPass(pool, &job);
+}
+
+// --------------------------------------------------------------------
+HLL_API tListReduce heaplessList_parallelReduce(heaplessList* l, heaplessParallelPool* pool, tListReduce identity,
+                                                heaplessList_accumulateFunction accumulate,
+                                                heaplessList_combineFunction combine, void* context)
+{
+    heaplessParallelJob job;
+    tListReduce result = identity;
+    uint32_t i;
+
+    //check inputs
+    if( NULL_PTR == l || NULL_PTR == l->liveBitmap || NULL_PTR == accumulate || NULL_PTR == combine ){
+        HLL_ASSERT(false,1);
+        return identity;
+    }
+
+    job.list = l;
+    job.forEach = NULL_PTR;
+    job.accumulate = accumulate;
+    job.context = context;
+    job.identity = identity;
+    parallelRunPass(pool, &job);
+
+    for( i = 0; i < atomic_load_explicit( &(job.numberOfPartials), memory_order_relaxed ); i++ ){
+        result = combine( result, job.partial[i] );
+    }
+    return result;
+}
+
+#endif /* HLL_PARALLEL */
@@ -0,0 +1,186 @@
+/**
+ * @file heaplessPriorityList.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief priority list without heap implementation.
+ * The highest lane with elements is found with count leading zeros in the ready
+ * bitmap, so no empty lane is ever visited
+ * @version 0.1
+ */
+
+#include "heaplessPriorityList.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+/**
+ * @brief add the node in the end of the lane
+ *
+ * @param pl pointer to the priority list
+ * @param i index of the node
+ * @param priority lane
+ */
+inline static void priorityLinkNode(heaplessPriorityList* pl, tIndex i, uint8_t priority)
+{
+    heaplessPriorityNode* n = &( pl->nodes[i] );
+
+    n->priority = priority;
+    n->nextNode = HLL_NULL;
+    n->previousNode = pl->lastNodeIndex[priority];
+    if( HLL_NULL == n->previousNode ){ // lane was empty
+        pl->firstNodeIndex[priority] = i;
+        pl->readyBitmap |= (uint32_t)1u << priority;
+    }
+    else{
+        pl->nodes[n->previousNode].nextNode = i;
+    }
+    pl->lastNodeIndex[priority] = i;
+}
+
+/**
+ * @brief remove the node from its lane
+ *
+ * @param pl pointer to the priority list
+ * @param i index of the node
+ */
+inline static void priorityUnlinkNode(heaplessPriorityList* pl, tIndex i)
+{
+    heaplessPriorityNode* n = &( pl->nodes[i] );
+
+    if( HLL_NULL == n->previousNode )
+        pl->firstNodeIndex[n->priority] = n->nextNode;
+    else
+        pl->nodes[n->previousNode].nextNode = n->nextNode;
+
+    if( HLL_NULL == n->nextNode )
+        pl->lastNodeIndex[n->priority] = n->previousNode;
+    else
+        pl->nodes[n->nextNode].previousNode = n->previousNode;
+
+    if( HLL_NULL == pl->firstNodeIndex[n->priority] ){ // lane is empty now
+        pl->readyBitmap &= ~((uint32_t)1u << n->priority);
+    }
+}
+
+/**
+ * @brief first node of the highest priority lane with elements
+ *
+ * @param pl pointer to the priority list
+ * @return index of the node, HLL_NULL if all the lanes are empty
+ */
+inline static tIndex priorityHighestNode(heaplessPriorityList* pl)
+{
+    tIndex i = HLL_NULL;
+
+    if( 0u != pl->readyBitmap ){
+        i = pl->firstNodeIndex[31u - HLL_CLZ32(pl->readyBitmap)];
+    }
+    return i;
+}
+
+/**
+ * @brief check if the index is a node used by one of the lanes
+ */
+inline static bool priorityIsNodeInList(heaplessPriorityList* pl, tIndex i)
+{
+    return i < pl->cMaxLength && HLL_PRIORITY_FREE != pl->nodes[i].priority;
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessPriorityList_init(heaplessPriorityList* pl, tIndex* ringBufferArray, heaplessPriorityNode* nodeArray, tIndex maxSize)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == pl || NULL_PTR == ringBufferArray ||
+        NULL_PTR == nodeArray || 0u == maxSize ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    pl->nodes = nodeArray;
+    pl->cMaxLength = maxSize;
+    pl->readyBitmap = 0u;
+    ringBuffer_init( &(pl->allocationTable), ringBufferArray, maxSize );
+
+    for( i = 0; i < HLL_PRIORITY_LANES; i++ ){
+        pl->firstNodeIndex[i] = HLL_NULL;
+        pl->lastNodeIndex[i] = HLL_NULL;
+    }
+    // add the list of free spaces in the ringBuffer
+    for( i = 0; i < maxSize; i++ ){
+        pl->nodes[i].priority = HLL_PRIORITY_FREE;
+        ringBuffer_addData( &(pl->allocationTable), i );
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex heaplessPriorityList_push(heaplessPriorityList* pl, uint8_t priority, tListData data)
+{
+    tIndex i = HLL_NULL;
+
+    if( priority < HLL_PRIORITY_LANES ){
+        i = ringBuffer_popData( &(pl->allocationTable) ); // malloc
+        if( HLL_NULL != i ){
+            pl->nodes[i].data = data;
+            priorityLinkNode(pl, i, priority);
+        }
+    }
+    return i;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessPriorityList_pop(heaplessPriorityList* pl, tListData* output)
+{
+    bool isListNotEmpty = false;
+    tIndex i = priorityHighestNode(pl);
+
+    if( HLL_NULL != i ){
+        *output = pl->nodes[i].data;
+        isListNotEmpty = heaplessPriorityList_remove(pl, i);
+    }
+    return isListNotEmpty;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessPriorityList_getFirst(heaplessPriorityList* pl, tListData* output)
+{
+    bool isListNotEmpty = false;
+    tIndex i = priorityHighestNode(pl);
+
+    if( HLL_NULL != i ){
+        *output = pl->nodes[i].data;
+        isListNotEmpty = true;
+    }
+    return isListNotEmpty;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessPriorityList_reprioritize(heaplessPriorityList* pl, tIndex node, uint8_t priority)
+{
+    bool isOperationOk = false;
+
+    if( priority < HLL_PRIORITY_LANES && priorityIsNodeInList(pl, node) ){
+        priorityUnlinkNode(pl, node);
+        priorityLinkNode(pl, node, priority);
+        isOperationOk = true;
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessPriorityList_remove(heaplessPriorityList* pl, tIndex node)
+{
+    bool isOperationOk = false;
+
+    if( priorityIsNodeInList(pl, node) ){
+        priorityUnlinkNode(pl, node);
+        pl->nodes[node].priority = HLL_PRIORITY_FREE;
+        isOperationOk = ringBuffer_addData( &(pl->allocationTable), node ); // free
+    }
+    return isOperationOk;
+}
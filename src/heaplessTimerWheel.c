@@ -0,0 +1,180 @@
+/**
+ * @file heaplessTimerWheel.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief hierarchical timing wheel without heap implementation.
+ * Every slot is a doubly linked list of indexes (like heaplessList), and all
+ * the slots take their nodes from the same pool, so schedule and cancel are O(1)
+ * @version 0.1
+ */
+
+#include "heaplessTimerWheel.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+/**
+ * @brief find the slot of the timer (based on the distance to the current tick)
+ * and add it in the beginning of the slot list
+ *
+ * @param tw pointer to the timer wheel
+ * @param i index of the timer node
+ */
+static void wheelLinkTimer(heaplessTimerWheel* tw, tIndex i)
+{
+    heaplessTimerNode* n = &( tw->timers[i] );
+    tTimerTick expiry = n->expiry;
+    uint64_t delta = (tTimerTick)( expiry - tw->currentTick );
+    tIndex level = 0u;
+    tIndex slot;
+
+    while( level < HLL_TW_LEVELS - 1u &&
+           delta >= ((uint64_t)1u << ((level + 1u) * HLL_TW_SLOT_BITS)) ){
+        level++;
+    }
+    // too far away for the last level, park it in the furthest slot. It will be cascaded again
+    if( delta >= ((uint64_t)1u << (HLL_TW_LEVELS * HLL_TW_SLOT_BITS)) ){
+        expiry = tw->currentTick + (tTimerTick)(((uint64_t)1u << (HLL_TW_LEVELS * HLL_TW_SLOT_BITS)) - 1u);
+    }
+    slot = (tIndex)( level * HLL_TW_SLOTS + ((expiry >> (level * HLL_TW_SLOT_BITS)) & HLL_TW_SLOT_MASK) );
+
+    n->slot = slot;
+    n->previousNode = HLL_NULL;
+    n->nextNode = tw->slotHead[slot];
+    if( HLL_NULL != n->nextNode ){
+        tw->timers[n->nextNode].previousNode = i;
+    }
+    tw->slotHead[slot] = i;
+}
+
+/**
+ * @brief remove the timer from its slot list (same unlink used by heaplessList_removeAndNextIt)
+ *
+ * @param tw pointer to the timer wheel
+ * @param i index of the timer node
+ */
+inline static void wheelUnlinkTimer(heaplessTimerWheel* tw, tIndex i)
+{
+    heaplessTimerNode* n = &( tw->timers[i] );
+
+    if( HLL_NULL == n->previousNode )
+        tw->slotHead[n->slot] = n->nextNode;
+    else
+        tw->timers[n->previousNode].nextNode = n->nextNode;
+
+    if( HLL_NULL != n->nextNode )
+        tw->timers[n->nextNode].previousNode = n->previousNode;
+}
+
+/**
+ * @brief move all the timers of a higher level slot to the lower levels
+ *
+ * @param tw pointer to the timer wheel
+ * @param slot to be cascaded
+ */
+static void wheelCascadeSlot(heaplessTimerWheel* tw, tIndex slot)
+{
+    tIndex i = tw->slotHead[slot];
+    tIndex next;
+
+    tw->slotHead[slot] = HLL_NULL;
+    while( HLL_NULL != i ){
+        next = tw->timers[i].nextNode;
+        wheelLinkTimer(tw, i);
+        i = next;
+    }
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessTimerWheel_init(heaplessTimerWheel* tw, tIndex* ringBufferArray, heaplessTimerNode* timerArray, tIndex maxSize)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == tw || NULL_PTR == ringBufferArray ||
+        NULL_PTR == timerArray || 0u == maxSize ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    tw->timers = timerArray;
+    tw->cMaxLength = maxSize;
+    tw->currentTick = 0u;
+    ringBuffer_init( &(tw->allocationTable), ringBufferArray, maxSize );
+
+    for( i = 0; i < HLL_TW_TOTAL_SLOTS; i++ ){
+        tw->slotHead[i] = HLL_NULL;
+    }
+    // add the list of free spaces in the ringBuffer
+    for( i = 0; i < maxSize; i++ ){
+        tw->timers[i].slot = HLL_NULL;
+        ringBuffer_addData( &(tw->allocationTable), i );
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex heaplessTimerWheel_schedule(heaplessTimerWheel* tw, tTimerTick delay, tListData data)
+{
+    tIndex i;
+
+    i = ringBuffer_popData( &(tw->allocationTable) ); // malloc
+    if( HLL_NULL != i ){
+        tw->timers[i].expiry = tw->currentTick + ( 0u == delay ? 1u : delay );
+        tw->timers[i].data = data;
+        wheelLinkTimer(tw, i);
+    }
+    return i;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessTimerWheel_cancel(heaplessTimerWheel* tw, tIndex timer)
+{
+    bool isOperationOk = false;
+
+    if( timer < tw->cMaxLength && HLL_NULL != tw->timers[timer].slot ){
+        wheelUnlinkTimer(tw, timer);
+        tw->timers[timer].slot = HLL_NULL;
+        isOperationOk = ringBuffer_addData( &(tw->allocationTable), timer ); // free
+    }
+    return isOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex heaplessTimerWheel_tick(heaplessTimerWheel* tw, heaplessTimerWheel_callback cb)
+{
+    tIndex level;
+    tIndex index;
+    tIndex slot;
+    tIndex i;
+    tIndex expiredTimers = 0u;
+
+    tw->currentTick++;
+
+    // level 0 completed a turn, bring the timers of the next level down
+    if( 0u == (tw->currentTick & HLL_TW_SLOT_MASK) ){
+        for( level = 1u; level < HLL_TW_LEVELS; level++ ){
+            index = (tIndex)( (tw->currentTick >> (level * HLL_TW_SLOT_BITS)) & HLL_TW_SLOT_MASK );
+            wheelCascadeSlot(tw, (tIndex)(level * HLL_TW_SLOTS + index));
+            if( 0u != index ){
+                break;
+            }
+        }
+    }
+
+    // the list is read from the head every time, because the callback may cancel timers
+    slot = (tIndex)( tw->currentTick & HLL_TW_SLOT_MASK );
+    while( HLL_NULL != (i = tw->slotHead[slot]) ){
+        wheelUnlinkTimer(tw, i);
+        tw->timers[i].slot = HLL_NULL;
+        (void)ringBuffer_addData( &(tw->allocationTable), i ); // free
+        expiredTimers++;
+        if( NULL_PTR != cb ){
+            cb(i, tw->timers[i].data);
+        }
+    }
+    return expiredTimers;
+}
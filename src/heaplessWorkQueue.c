@@ -0,0 +1,192 @@
+/**
+ * @file heaplessWorkQueue.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief work stealing queue without heap implementation.
+ * Fixed size version of the Chase-Lev deque, using the C11 memory model from
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al.)
+ * @version 0.1
+ */
+
+#include <sched.h>
+#include "heaplessWorkQueue.h"
+
+/*****************************************
+ ********* private functions *************
+ *****************************************/
+
+/**
+ * @brief position of the counter (top or bottom) inside the task array
+ *
+ * @param d pointer to the deque
+ * @param i top or bottom counter (they never go back to zero)
+ */
+inline static heaplessWorkItem* workTaskAt(heaplessWorkDeque* d, int_fast64_t i)
+{
+    return &( d->tasks[i % d->cMaxLength] );
+}
+
+/**
+ * @brief find the victim with more tasks waiting. The sizes are only an
+ * estimation, because the other workers keep changing them
+ *
+ * @param wq pointer to the work queue
+ * @param worker id of the thief (never chosen)
+ * @return victim id, HLL_NULL if all the other deques look empty
+ */
+static tIndex workFindVictim(heaplessWorkQueue* wq, tIndex worker)
+{
+    tIndex victim = HLL_NULL;
+    tIndex i;
+    tIndex candidate;
+    int_fast64_t size;
+    int_fast64_t biggestSize = 0;
+
+    // start after the thief, so the workers do not all look at the same deque first
+    for( i = 1u; i < wq->numberOfWorkers; i++ ){
+        candidate = (tIndex)( (worker + i) % wq->numberOfWorkers );
+        size = atomic_load_explicit( &(wq->deques[candidate].bottom), memory_order_relaxed ) -
+               atomic_load_explicit( &(wq->deques[candidate].top), memory_order_relaxed );
+        if( size > biggestSize ){
+            biggestSize = size;
+            victim = candidate;
+        }
+    }
+    return victim;
+}
+
+/*****************************************
+ ********* public functions **************
+ *****************************************/
+
+// --------------------------------------------------------------------
+HLL_API void heaplessWorkQueue_init(heaplessWorkQueue* wq, heaplessWorkDeque* dequeArray, heaplessWorkItem* taskArray,
+                                    tIndex numberOfWorkers, tIndex capacityPerWorker)
+{
+    tIndex i;
+
+    //check inputs
+    if( NULL_PTR == wq || NULL_PTR == dequeArray || NULL_PTR == taskArray ||
+        0u == numberOfWorkers || 0u == capacityPerWorker ){
+        HLL_ASSERT(false,1);
+        return;
+    }
+
+    wq->deques = dequeArray;
+    wq->numberOfWorkers = numberOfWorkers;
+    atomic_init( &(wq->pendingTasks), 0 );
+    atomic_init( &(wq->stop), false );
+
+    for( i = 0; i < numberOfWorkers; i++ ){
+        atomic_init( &(dequeArray[i].top), 0 );
+        atomic_init( &(dequeArray[i].bottom), 0 );
+        dequeArray[i].tasks = &( taskArray[(uint_fast32_t)i * capacityPerWorker] );
+        dequeArray[i].cMaxLength = capacityPerWorker;
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessWorkQueue_push(heaplessWorkQueue* wq, tIndex worker, tListData task)
+{
+    heaplessWorkDeque* d = &( wq->deques[worker] );
+    int_fast64_t b = atomic_load_explicit( &(d->bottom), memory_order_relaxed );
+    int_fast64_t t = atomic_load_explicit( &(d->top), memory_order_acquire );
+    bool wasOperationOk = false;
+
+    if( b - t < d->cMaxLength ){
+        atomic_fetch_add_explicit( &(wq->pendingTasks), 1, memory_order_relaxed );
+        atomic_store_explicit( workTaskAt(d, b), task, memory_order_relaxed );
+        atomic_thread_fence( memory_order_release );
+        atomic_store_explicit( &(d->bottom), b + 1, memory_order_relaxed );
+        wasOperationOk = true;
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessWorkQueue_pop(heaplessWorkQueue* wq, tIndex worker, tListData* task)
+{
+    heaplessWorkDeque* d = &( wq->deques[worker] );
+    int_fast64_t b = atomic_load_explicit( &(d->bottom), memory_order_relaxed ) - 1;
+    int_fast64_t t;
+    bool isDequeNotEmpty = false;
+
+    // reserve the bottom task before looking at the top
+    atomic_store_explicit( &(d->bottom), b, memory_order_relaxed );
+    atomic_thread_fence( memory_order_seq_cst );
+    t = atomic_load_explicit( &(d->top), memory_order_relaxed );
+
+    if( t <= b ){
+        *task = atomic_load_explicit( workTaskAt(d, b), memory_order_relaxed );
+        isDequeNotEmpty = true;
+        if( t == b ){
+            // last task, the thieves may want it too
+            if( !atomic_compare_exchange_strong_explicit( &(d->top), &t, t + 1,
+                                                          memory_order_seq_cst, memory_order_relaxed ) ){
+                isDequeNotEmpty = false;
+            }
+            atomic_store_explicit( &(d->bottom), b + 1, memory_order_relaxed );
+        }
+    }
+    else{
+        atomic_store_explicit( &(d->bottom), b + 1, memory_order_relaxed );
+    }
+    return isDequeNotEmpty;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool heaplessWorkQueue_steal(heaplessWorkQueue* wq, tIndex victim, tListData* task)
+{
+    heaplessWorkDeque* d = &( wq->deques[victim] );
+    int_fast64_t t = atomic_load_explicit( &(d->top), memory_order_acquire );
+    int_fast64_t b;
+    tListData stolenTask;
+    bool wasOperationOk = false;
+
+    atomic_thread_fence( memory_order_seq_cst );
+    b = atomic_load_explicit( &(d->bottom), memory_order_acquire );
+
+    if( t < b ){
+        stolenTask = atomic_load_explicit( workTaskAt(d, t), memory_order_relaxed );
+        if( atomic_compare_exchange_strong_explicit( &(d->top), &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed ) ){
+            *task = stolenTask;
+            wasOperationOk = true;
+        }
+    }
+    return wasOperationOk;
+}
+
+// --------------------------------------------------------------------
+HLL_API void heaplessWorkQueue_run(heaplessWorkQueue* wq, tIndex worker, heaplessWorkQueue_handler handler)
+{
+    tListData task;
+    tIndex victim;
+    bool hasTask;
+
+    while( !atomic_load_explicit( &(wq->stop), memory_order_relaxed ) &&
+           0 != atomic_load_explicit( &(wq->pendingTasks), memory_order_acquire ) ){
+
+        hasTask = heaplessWorkQueue_pop(wq, worker, &task);
+        if( !hasTask ){
+            victim = workFindVictim(wq, worker);
+            if( HLL_NULL != victim ){
+                hasTask = heaplessWorkQueue_steal(wq, victim, &task);
+            }
+        }
+
+        if( hasTask ){
+            handler(wq, worker, task);
+            atomic_fetch_sub_explicit( &(wq->pendingTasks), 1, memory_order_release );
+        }
+        else{
+            // the tasks left are running in other workers
+            sched_yield();
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+HLL_API void heaplessWorkQueue_stop(heaplessWorkQueue* wq)
+{
+    atomic_store_explicit( &(wq->stop), true, memory_order_relaxed );
+}
@@ -5,6 +5,7 @@
  * if you want a proper ring buffer go to something like https://github.com/dhess/c-ringbuf
  */
 
+#include <string.h>
 #include "ringBuffer.h"
 
 /*****************************************
@@ -22,12 +23,82 @@ inline static void __incrementIndex__(tIndex* i, tIndex maxSize)
     (*i)++; if( *i == maxSize ) *i = 0;
 }
 
+/**
+ * @brief decrement the index of the ring buffer accordingly, \
+ * going to the end when it was zero
+ * 
+ * @param i [ pointer to the index ]
+ */
+inline static void __decrementIndex__(tIndex* i, tIndex maxSize)
+{
+    if( *i == 0 ) *i = maxSize;
+    (*i)--;
+}
+
+/**
+ * @brief move the index forward by many positions at once, \
+ * going around the end of the array only once
+ * 
+ * @param i [ pointer to the index ]
+ * @param n [ number of positions (up to maxSize) ]
+ */
+inline static void __advanceIndex__(tIndex* i, tIndex n, tIndex maxSize)
+{
+    // written without *i + n, that may not fit in tIndex
+    *i = ( n < maxSize - *i ) ? (tIndex)(*i + n) : (tIndex)(n - (maxSize - *i));
+}
+
+/**
+ * @brief copy n elements starting at the tail, in two blocks if they go around the end
+ */
+inline static void __copyFromTail__(ringBuffer* rb, tIndex* output, tIndex n)
+{
+    tIndex firstBlock = rb->cMaxlenght - rb->tailIndex;
+
+    if( n < firstBlock ) firstBlock = n;
+    memcpy( output, &(rb->buffer[rb->tailIndex]), firstBlock * sizeof(tIndex) );
+    memcpy( output + firstBlock, rb->buffer, (size_t)(n - firstBlock) * sizeof(tIndex) );
+}
+
+/**
+ * @brief space used by a record: header plus data rounded up to the header size,
+ * so the headers are always aligned and never cross the end of the buffer
+ */
+inline static tIndex __recordSize__(tIndex len)
+{
+    return (tIndex)( RING_BUFFER_RECORD_HEADER +
+                     (len + RING_BUFFER_RECORD_HEADER - 1u) / RING_BUFFER_RECORD_HEADER * RING_BUFFER_RECORD_HEADER );
+}
+
+inline static tIndex __readHeader__(ringBufferBytes* rb, tIndex i)
+{
+    tIndex header;
+    memcpy( &header, &(rb->buffer[i]), sizeof(header) );
+    return header;
+}
+
+inline static void __writeHeader__(ringBufferBytes* rb, tIndex i, tIndex header)
+{
+    memcpy( &(rb->buffer[i]), &header, sizeof(header) );
+}
+
+/**
+ * @brief the consumer jumps to the beginning when it finds the wrap marker
+ */
+inline static void __skipWrapMarker__(ringBufferBytes* rb)
+{
+    if( rb->lenght > RING_BUFFER_EMPTY && RING_BUFFER_WRAP_MARKER == __readHeader__(rb, rb->tailIndex) ){
+        rb->lenght -= rb->cMaxlenght - rb->tailIndex;
+        rb->tailIndex = 0u;
+    }
+}
+
 /*****************************************
  ********* public functions **************
  *****************************************/
 
 // --------------------------------------------------------------------
-void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxSize)
+HLL_API void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxSize)
 {   
     rb->buffer = buffer;
     rb->cMaxlenght = maxSize;
@@ -37,7 +108,7 @@ void ringBuffer_init(ringBuffer* rb, tIndex* buffer, tIndex maxSize)
 }
 
 // --------------------------------------------------------------------
-bool ringBuffer_addData(ringBuffer* rb, tIndex data)
+HLL_API bool ringBuffer_addData(ringBuffer* rb, tIndex data)
 {
     bool wasOperationSuccessful = false;
 
@@ -52,7 +123,7 @@ bool ringBuffer_addData(ringBuffer* rb, tIndex data)
 }
 
 // --------------------------------------------------------------------
-tIndex ringBuffer_popData(ringBuffer* rb)
+HLL_API tIndex ringBuffer_popData(ringBuffer* rb)
 {
     tIndex popedData = HLL_NULL;
 
@@ -64,3 +135,162 @@ tIndex ringBuffer_popData(ringBuffer* rb)
     
     return popedData;
 }
+
+// --------------------------------------------------------------------
+HLL_API tIndex ringBuffer_addN(ringBuffer* rb, const tIndex* data, tIndex n)
+{
+    tIndex count = rb->cMaxlenght - rb->lenght;
+    tIndex firstBlock = rb->cMaxlenght - rb->headIndex;
+
+    if( n < count ) count = n;
+    if( count < firstBlock ) firstBlock = count;
+
+    memcpy( &(rb->buffer[rb->headIndex]), data, firstBlock * sizeof(tIndex) );
+    memcpy( rb->buffer, data + firstBlock, (size_t)(count - firstBlock) * sizeof(tIndex) );
+    __advanceIndex__( &(rb->headIndex), count, rb->cMaxlenght );
+    rb->lenght += count;
+
+    return count;
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex ringBuffer_popN(ringBuffer* rb, tIndex* output, tIndex n)
+{
+    tIndex count = ( n < rb->lenght ) ? n : rb->lenght;
+
+    __copyFromTail__( rb, output, count );
+    __advanceIndex__( &(rb->tailIndex), count, rb->cMaxlenght );
+    rb->lenght -= count;
+
+    return count;
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex ringBuffer_peekN(ringBuffer* rb, tIndex* output, tIndex n)
+{
+    tIndex count = ( n < rb->lenght ) ? n : rb->lenght;
+
+    __copyFromTail__( rb, output, count );
+
+    return count;
+}
+
+// --------------------------------------------------------------------
+HLL_API void ringBuffer_initBytes(ringBufferBytes* rb, uint8_t* buffer, tIndex size)
+{
+    rb->buffer = buffer;
+    rb->cMaxlenght = (tIndex)( size - size % RING_BUFFER_RECORD_HEADER );
+    rb->headIndex = 0u;
+    rb->tailIndex = 0u;
+    rb->lenght = RING_BUFFER_EMPTY;
+    rb->reservedIndex = 0u;
+    rb->reservedLenght = HLL_NULL;
+    rb->isReservedWrapped = false;
+}
+
+// --------------------------------------------------------------------
+HLL_API uint8_t* ringBuffer_reserve(ringBufferBytes* rb, tIndex len)
+{
+    uint8_t* span = NULL_PTR;
+    tIndex size;
+
+    rb->reservedLenght = HLL_NULL; // a new reserve drops the one not committed
+    if( len < rb->cMaxlenght && RING_BUFFER_RECORD_HEADER <= rb->cMaxlenght - len ){
+        size = __recordSize__(len);
+        if( RING_BUFFER_EMPTY == rb->lenght ){ // empty, all the buffer is contiguous
+            rb->headIndex = 0u;
+            rb->tailIndex = 0u;
+        }
+
+        if( rb->headIndex < rb->tailIndex ){ // free space is between head and tail
+            if( size <= rb->tailIndex - rb->headIndex ){
+                rb->reservedIndex = rb->headIndex;
+                rb->isReservedWrapped = false;
+                rb->reservedLenght = len;
+            }
+        }
+        else if( rb->lenght < rb->cMaxlenght ){ // free space is in the end and in the beginning
+            if( size <= rb->cMaxlenght - rb->headIndex ){
+                rb->reservedIndex = rb->headIndex;
+                rb->isReservedWrapped = false;
+                rb->reservedLenght = len;
+            }
+            else if( size <= rb->tailIndex ){ // skip the end of the buffer
+                rb->reservedIndex = 0u;
+                rb->isReservedWrapped = true;
+                rb->reservedLenght = len;
+            }
+        }
+
+        if( HLL_NULL != rb->reservedLenght ){
+            span = &( rb->buffer[rb->reservedIndex + RING_BUFFER_RECORD_HEADER] );
+        }
+    }
+    return span;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool ringBuffer_commit(ringBufferBytes* rb, tIndex len)
+{
+    bool wasOperationSuccessful = false;
+    tIndex size;
+
+    if( HLL_NULL != rb->reservedLenght && len <= rb->reservedLenght ){
+        if( rb->isReservedWrapped ){
+            __writeHeader__( rb, rb->headIndex, RING_BUFFER_WRAP_MARKER );
+            rb->lenght += rb->cMaxlenght - rb->headIndex;
+        }
+        size = __recordSize__(len);
+        __writeHeader__( rb, rb->reservedIndex, len );
+        rb->headIndex = rb->reservedIndex;
+        __advanceIndex__( &(rb->headIndex), size, rb->cMaxlenght );
+        rb->lenght += size;
+        rb->reservedLenght = HLL_NULL;
+        wasOperationSuccessful = true;
+    }
+    return wasOperationSuccessful;
+}
+
+// --------------------------------------------------------------------
+HLL_API uint8_t* ringBuffer_peek(ringBufferBytes* rb, tIndex* len)
+{
+    uint8_t* record = NULL_PTR;
+
+    __skipWrapMarker__(rb);
+    if( rb->lenght > RING_BUFFER_EMPTY ){
+        *len = __readHeader__(rb, rb->tailIndex);
+        record = &( rb->buffer[rb->tailIndex + RING_BUFFER_RECORD_HEADER] );
+    }
+    return record;
+}
+
+// --------------------------------------------------------------------
+HLL_API bool ringBuffer_release(ringBufferBytes* rb)
+{
+    bool wasOperationSuccessful = false;
+    tIndex size;
+
+    __skipWrapMarker__(rb);
+    if( rb->lenght > RING_BUFFER_EMPTY ){
+        size = __recordSize__( __readHeader__(rb, rb->tailIndex) );
+        __advanceIndex__( &(rb->tailIndex), size, rb->cMaxlenght );
+        rb->lenght -= size;
+        __skipWrapMarker__(rb);
+        wasOperationSuccessful = true;
+    }
+    return wasOperationSuccessful;
+}
+
+// --------------------------------------------------------------------
+HLL_API tIndex ringBuffer_popLastData(ringBuffer* rb)
+{
+    tIndex popedData = HLL_NULL;
+
+    if( rb->lenght > RING_BUFFER_EMPTY ){
+        __decrementIndex__( &(rb->headIndex), rb->cMaxlenght );
+        popedData = rb->buffer[rb->headIndex];
+        rb->lenght--;
+    }
+
+    return popedData;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file benchmark.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief benchmark of the heaplessList hot paths.
+ * Build it with different flags (see makefile) to compare the list modes
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "heaplessLinkedList.h"
+#include "benchmark.h"
+
+#ifdef HLL_LARGE_CAPACITY
+#include <sys/mman.h>
+#endif
+
+#define BENCHMARK_LIST_SIZE 1024
+#define BENCHMARK_OPERATIONS 20000000u
+
+static tIndex allocationArray[BENCHMARK_LIST_SIZE];
+static heaplessListNode heapMemory[BENCHMARK_LIST_SIZE];
+
+#ifdef HLL_SENTINEL_NODE
+#define BENCHMARK_MODE "sentinel node"
+#else
+#define BENCHMARK_MODE "first/last indexes"
+#endif
+
+#ifdef HLL_HEADER_ONLY
+#define BENCHMARK_BUILD "header-only"
+#else
+#define BENCHMARK_BUILD "library"
+#endif
+
+/**
+ * @brief random mix of appends, removals in both ends and removals in the middle,
+ * so the first/last/single element cases are not predictable
+ */
+static uint32_t mixedWorkload(heaplessList* l, uint32_t operations)
+{
+    uint32_t seed = 0x12345678u;
+    uint32_t checksum = 0u;
+    uint32_t i;
+    uint32_t r;
+    tListData data;
+    heaplessListNode* n;
+
+    for( i = 0; i < operations; i++ ){
+        r = benchmark_random(&seed);
+        switch( r & 7u ){
+            case 0: case 1: case 2: case 3:
+                (void)heaplessList_append(l, (tListData)r);
+                break;
+            case 4:
+                if( heaplessList_pop(l, &data) ) checksum += data;
+                break;
+            case 5:
+                (void)heaplessList_removeLast(l);
+                break;
+            default:
+                // remove one of the first nodes through the iterator
+                n = heaplessList_initIt(l);
+                if( NULL_PTR != n && (r & 0x100u) ) (void)heaplessList_nextIt(l, &n);
+                if( NULL_PTR != n ) (void)heaplessList_removeAndNextIt(l, &n);
+                break;
+        }
+        // keep the list small, so the empty and single element cases happen a lot
+        if( (r & 0x3F000u) == 0u ){
+            while( heaplessList_removeFirst(l) );
+        }
+    }
+    return checksum;
+}
+
+/**
+ * @brief tight loops where the call overhead is most of the work:
+ * append/pop pairs and a full walk with the iterator, elements is the number of appended elements
+ */
+static uint32_t tightLoops(heaplessList* l, uint32_t rounds, uint32_t* elements)
+{
+    uint32_t checksum = 0u;
+    uint32_t i;
+    tListData data;
+    heaplessListNode* n;
+
+    *elements = 0u;
+    for( i = 0; i < rounds; i++ ){
+        while( heaplessList_append(l, (tListData)i) ) (*elements)++;
+        n = heaplessList_initIt(l);
+        do{
+            checksum += heaplessList_getItData(n);
+        }while( heaplessList_nextIt(l, &n) );
+        while( heaplessList_pop(l, &data) ) checksum += data;
+    }
+    return checksum;
+}
+
+/**
+ * @brief move blocks through the ring buffer, one element per call and with the bulk functions
+ */
+static void ringBufferBenchmark(void)
+{
+    static tIndex block[BENCHMARK_LIST_SIZE / 4];
+    static tIndex ringArray[BENCHMARK_LIST_SIZE];
+    ringBuffer rb;
+    uint32_t i;
+    uint32_t j;
+    uint32_t checksum = 0u;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t rounds = BENCHMARK_OPERATIONS / (BENCHMARK_LIST_SIZE / 4);
+
+    for( j = 0; j < BENCHMARK_LIST_SIZE / 4; j++ ) block[j] = (tIndex)j;
+    ringBuffer_init(&rb, ringArray, BENCHMARK_LIST_SIZE - 3); // blocks do not align with the end
+
+    start = benchmark_nowNs();
+    for( i = 0; i < rounds; i++ ){
+        for( j = 0; j < BENCHMARK_LIST_SIZE / 4; j++ ) (void)ringBuffer_addData(&rb, block[j]);
+        for( j = 0; j < BENCHMARK_LIST_SIZE / 4; j++ ) checksum += ringBuffer_popData(&rb);
+    }
+    elapsed = benchmark_nowNs() - start;
+    printf("ring buffer one by one: %.3f ns/element, checksum %u\n", (double)elapsed / BENCHMARK_OPERATIONS, checksum);
+
+    checksum = 0u;
+    start = benchmark_nowNs();
+    for( i = 0; i < rounds; i++ ){
+        (void)ringBuffer_addN(&rb, block, BENCHMARK_LIST_SIZE / 4);
+        (void)ringBuffer_popN(&rb, block, BENCHMARK_LIST_SIZE / 4);
+        checksum += block[i % (BENCHMARK_LIST_SIZE / 4)];
+    }
+    elapsed = benchmark_nowNs() - start;
+    printf("ring buffer in blocks:  %.3f ns/element, checksum %u\n", (double)elapsed / BENCHMARK_OPERATIONS, checksum);
+}
+
+#ifdef HLL_LARGE_CAPACITY
+#define BENCHMARK_LARGE_SIZE (1u << 21) // 2M nodes
+
+#ifdef HLL_LIFO_ALLOCATION
+#define BENCHMARK_ALLOCATION "LIFO allocation"
+#else
+#define BENCHMARK_ALLOCATION "FIFO allocation"
+#endif
+
+/**
+ * @brief memory for the big pools, in huge pages when the system has them
+ * (less TLB misses walking millions of nodes)
+ */
+static void* hugePageAlloc(size_t bytes, const char** kind)
+{
+    void* p = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    *kind = "hugetlb";
+#endif
+    if( MAP_FAILED == p ){
+        p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        *kind = "4k pages";
+#ifdef MADV_HUGEPAGE
+        if( MAP_FAILED != p && 0 == madvise(p, bytes, MADV_HUGEPAGE) ) *kind = "transparent huge pages";
+#endif
+    }
+    return MAP_FAILED == p ? NULL : p;
+}
+
+/**
+ * @brief queue usage (append in the end, pop in the beginning) with different
+ * number of elements inside a pool of 2M nodes. The cost per operation must not grow
+ */
+static void largeListBenchmark(void)
+{
+    static const uint32_t occupancies[] = { 1000u, 65536u, 1000000u, BENCHMARK_LARGE_SIZE - 1u };
+    const char* kind = "";
+    tIndex* ringArray = hugePageAlloc(BENCHMARK_LARGE_SIZE * sizeof(tIndex), &kind);
+    heaplessListNode* nodes = hugePageAlloc(BENCHMARK_LARGE_SIZE * sizeof(heaplessListNode), &kind);
+    heaplessList l;
+    uint32_t o;
+    uint32_t i;
+    uint32_t checksum = 0u;
+    uint64_t start;
+    uint64_t elapsed;
+    tListData data;
+
+    if( NULL == ringArray || NULL == nodes ){
+        printf("large list: no memory for %u nodes\n", BENCHMARK_LARGE_SIZE);
+        return;
+    }
+    heaplessList_init(&l, ringArray, nodes, BENCHMARK_LARGE_SIZE);
+
+    for( o = 0; o < sizeof(occupancies) / sizeof(occupancies[0]); o++ ){
+        while( heaplessList_removeFirst(&l) );
+        for( i = 0; i < occupancies[o]; i++ ) (void)heaplessList_append(&l, (tListData)i);
+
+        start = benchmark_nowNs();
+        for( i = 0; i < BENCHMARK_OPERATIONS / 4u; i++ ){
+            (void)heaplessList_pop(&l, &data);
+            checksum += data;
+            (void)heaplessList_append(&l, (tListData)i);
+        }
+        elapsed = benchmark_nowNs() - start;
+        printf("large list (%s, %s, %zu bytes/node): %7u elements, %.2f ns per pop+append, checksum %u\n",
+               BENCHMARK_ALLOCATION, kind, sizeof(heaplessListNode), occupancies[o],
+               (double)elapsed / (BENCHMARK_OPERATIONS / 4u), checksum);
+    }
+    munmap(ringArray, BENCHMARK_LARGE_SIZE * sizeof(tIndex));
+    munmap(nodes, BENCHMARK_LARGE_SIZE * sizeof(heaplessListNode));
+}
+#endif
+
+int main(void)
+{
+    heaplessList l;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t checksum;
+    uint32_t elements;
+    int64_t branchMisses;
+    int64_t branches;
+    int missesCounter = benchmark_openCounter(PERF_COUNT_HW_BRANCH_MISSES);
+    int branchesCounter = benchmark_openCounter(PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+
+    heaplessList_init(&l, allocationArray, heapMemory, BENCHMARK_LIST_SIZE);
+
+    benchmark_startCounter(missesCounter);
+    benchmark_startCounter(branchesCounter);
+    start = benchmark_nowNs();
+    checksum = mixedWorkload(&l, BENCHMARK_OPERATIONS);
+    elapsed = benchmark_nowNs() - start;
+    branchMisses = benchmark_stopCounter(missesCounter);
+    branches = benchmark_stopCounter(branchesCounter);
+
+    printf("mixed workload (%s, %s): %u ops, %.2f ns/op, checksum %u\n",
+           BENCHMARK_MODE, BENCHMARK_BUILD, BENCHMARK_OPERATIONS, (double)elapsed / BENCHMARK_OPERATIONS, checksum);
+    if( branchMisses >= 0 && branches > 0 ){
+        printf("  branches %lld, branch misses %lld (%.2f%%)\n",
+               (long long)branches, (long long)branchMisses, 100.0 * (double)branchMisses / (double)branches);
+    }
+    else{
+        printf("  branch counters not available (perf_event_open not allowed)\n");
+    }
+
+    start = benchmark_nowNs();
+    checksum = tightLoops(&l, BENCHMARK_OPERATIONS / (3u * BENCHMARK_LIST_SIZE), &elements);
+    elapsed = benchmark_nowNs() - start;
+    printf("tight loops (%s, %s): %.2f ns/element, checksum %u\n",
+           BENCHMARK_MODE, BENCHMARK_BUILD, (double)elapsed / elements, checksum);
+
+    ringBufferBenchmark();
+
+#ifdef HLL_LARGE_CAPACITY
+    largeListBenchmark();
+#endif
+    return 0;
+}
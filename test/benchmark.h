@@ -0,0 +1,97 @@
+/**
+ * @file benchmark.h
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief small helpers shared by the benchmarks (time and hardware counters)
+ */
+
+#ifndef HLL_BENCHMARK_H
+#define HLL_BENCHMARK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief monotonic time in nanoseconds
+ */
+static inline uint64_t benchmark_nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief small xorshift generator, so every run does the same sequence
+ */
+static inline uint32_t benchmark_random(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief open a hardware counter for the calling thread (user space only)
+ *
+ * @param config PERF_COUNT_HW_* value
+ * @return file descriptor, negative if not available (no linux / no permission)
+ */
+static inline int benchmark_openCounter(uint64_t config)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    (void)config;
+    return -1;
+#endif
+}
+
+static inline void benchmark_startCounter(int fd)
+{
+#ifdef __linux__
+    if( fd >= 0 ){
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+/**
+ * @brief stop the counter and read it
+ *
+ * @return counted events, -1 if the counter is not available
+ */
+static inline int64_t benchmark_stopCounter(int fd)
+{
+    int64_t value = -1;
+#ifdef __linux__
+    if( fd >= 0 ){
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if( sizeof(value) != read(fd, &value, sizeof(value)) ) value = -1;
+    }
+#else
+    (void)fd;
+#endif
+    return value;
+}
+
+#endif /* HLL_BENCHMARK_H */
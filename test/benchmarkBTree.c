@@ -0,0 +1,83 @@
+/**
+ * @file benchmarkBTree.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief time series index: range queries (all the entries between t1 and t2) in a
+ * heaplessBTree, and the same queries walking a sorted heaplessList as reference
+ */
+
+#include <stdio.h>
+#include "heaplessLinkedList.h"
+#include "heaplessBTree.h"
+#include "benchmark.h"
+
+#define BENCHMARK_ENTRIES 60000u
+#define BENCHMARK_NODES (BENCHMARK_ENTRIES / HLL_BTREE_MIN_KEYS + 16u)
+#define BENCHMARK_RANGE 64u  // entries in each query
+#define BENCHMARK_QUERIES 20000u
+
+static tIndex treeAllocationArray[BENCHMARK_NODES];
+static heaplessBTreeNode treeNodes[BENCHMARK_NODES];
+static heaplessBTree tree;
+static tIndex listAllocationArray[BENCHMARK_ENTRIES];
+static heaplessListNode listNodes[BENCHMARK_ENTRIES];
+static heaplessList list;
+
+int main(void)
+{
+    heaplessBTreeIt it;
+    heaplessListNode* n;
+    uint32_t state = 1u;
+    uint32_t checksum = 0u;
+    uint32_t query;
+    uint32_t t1;
+    tBTreeKey key;
+    uint64_t start;
+    uint64_t elapsed;
+
+    // the timestamps are the keys, the list keeps the same entries in order (key = position)
+    heaplessBTree_init(&tree, treeAllocationArray, treeNodes, BENCHMARK_NODES);
+    heaplessList_init(&list, listAllocationArray, listNodes, BENCHMARK_ENTRIES);
+    start = benchmark_nowNs();
+    for( key = 0u; key < BENCHMARK_ENTRIES; key++ ){
+        (void)heaplessBTree_insert(&tree, key, (tListData)key);
+    }
+    elapsed = benchmark_nowNs() - start;
+    for( key = 0u; key < BENCHMARK_ENTRIES; key++ ){
+        (void)heaplessList_append(&list, (tListData)key);
+    }
+    printf("btree: %u entries inserted in %.2f ns each, height %u\n", BENCHMARK_ENTRIES,
+           (double)elapsed / BENCHMARK_ENTRIES, (unsigned)tree.height);
+
+    start = benchmark_nowNs();
+    for( query = 0u; query < BENCHMARK_QUERIES; query++ ){
+        t1 = benchmark_random(&state) % (BENCHMARK_ENTRIES - BENCHMARK_RANGE);
+        if( heaplessBTree_lowerBound(&tree, t1, &it) ){
+            do{
+                if( heaplessBTree_getItKey(&tree, &it) >= t1 + BENCHMARK_RANGE ) break;
+                checksum += heaplessBTree_getItData(&tree, &it);
+            } while( heaplessBTree_nextIt(&tree, &it) );
+        }
+    }
+    elapsed = benchmark_nowNs() - start;
+    printf("btree: %.0f range queries/s (%u entries each), checksum %u\n",
+           (double)BENCHMARK_QUERIES * 1e9 / (double)elapsed, BENCHMARK_RANGE, checksum);
+
+    state = 1u;
+    checksum = 0u;
+    start = benchmark_nowNs();
+    for( query = 0u; query < BENCHMARK_QUERIES; query++ ){
+        t1 = benchmark_random(&state) % (BENCHMARK_ENTRIES - BENCHMARK_RANGE);
+        n = heaplessList_initIt(&list);
+        for( key = 0u; key < t1; key++ ){
+            (void)heaplessList_nextIt(&list, &n);
+        }
+        for( ; key < t1 + BENCHMARK_RANGE; key++ ){
+            checksum += heaplessList_getItData(n);
+            (void)heaplessList_nextIt(&list, &n);
+        }
+    }
+    elapsed = benchmark_nowNs() - start;
+    printf("list:  %.0f range queries/s (%u entries each), checksum %u\n",
+           (double)BENCHMARK_QUERIES * 1e9 / (double)elapsed, BENCHMARK_RANGE, checksum);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file benchmarkEpoch.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief read throughput of a list changed by one writer, from 1 to N readers.
+ * The readers iterate without locks (HLL_EPOCH_READERS), and the same test
+ * with a pthread rwlock is the reference
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "heaplessLinkedList.h"
+#include "benchmark.h"
+
+#ifndef HLL_EPOCH_READERS
+#error "build the benchmark with -DHLL_EPOCH_READERS"
+#endif
+
+#define BENCHMARK_LIST_SIZE 1024u
+#define BENCHMARK_ELEMENTS 512u
+#define BENCHMARK_TIME_NS 300000000u
+
+static tIndex allocationArray[BENCHMARK_LIST_SIZE];
+static heaplessListNode nodes[BENCHMARK_LIST_SIZE];
+static heaplessList list;
+static pthread_rwlock_t rwlock = PTHREAD_RWLOCK_INITIALIZER;
+static bool useLock;
+static atomic_bool stop;
+static _Atomic uint64_t passes;
+static _Atomic uint32_t checksum;
+
+static void* reader(void* arg)
+{
+    tIndex id = (tIndex)(uintptr_t)arg;
+    heaplessListNode* n;
+    uint32_t sum = 0u;
+    uint64_t myPasses = 0u;
+
+    while( !atomic_load_explicit(&stop, memory_order_relaxed) ){
+        if( useLock ) pthread_rwlock_rdlock(&rwlock);
+        else heaplessList_readBegin(&list, id);
+
+        n = heaplessList_initIt(&list);
+        do{
+            sum += heaplessList_getItData(n);
+        } while( heaplessList_nextIt(&list, &n) );
+
+        if( useLock ) pthread_rwlock_unlock(&rwlock);
+        else heaplessList_readEnd(&list, id);
+        myPasses++;
+    }
+    atomic_fetch_add(&passes, myPasses);
+    atomic_fetch_add(&checksum, sum);
+    return NULL;
+}
+
+/**
+ * @brief removes the first element and appends it again, the list always has elements
+ */
+static void* writer(void* arg)
+{
+    tListData data;
+
+    (void)arg;
+    while( !atomic_load_explicit(&stop, memory_order_relaxed) ){
+        if( useLock ) pthread_rwlock_wrlock(&rwlock);
+        (void)heaplessList_pop(&list, &data);
+        while( !heaplessList_append(&list, data) ) sched_yield(); // readers still hold the removed nodes
+        if( useLock ) pthread_rwlock_unlock(&rwlock);
+    }
+    return NULL;
+}
+
+static void readerScaling(long maxReaders)
+{
+    pthread_t threads[HLL_MAX_READERS];
+    pthread_t writerThread;
+    long readers;
+    long i;
+    tIndex j;
+    uint64_t start;
+    uint64_t elapsed;
+
+    for( readers = 1; readers <= maxReaders; readers++ ){
+        heaplessList_init(&list, allocationArray, nodes, BENCHMARK_LIST_SIZE);
+        for( j = 0; j < BENCHMARK_ELEMENTS; j++ ) (void)heaplessList_append(&list, (tListData)j);
+        atomic_store(&stop, false);
+        atomic_store(&passes, 0u);
+
+        start = benchmark_nowNs();
+        pthread_create(&writerThread, NULL, writer, NULL);
+        for( i = 0; i < readers; i++ ) pthread_create(&threads[i], NULL, reader, (void*)(uintptr_t)i);
+        while( benchmark_nowNs() - start < BENCHMARK_TIME_NS ) usleep(1000);
+        atomic_store(&stop, true);
+        for( i = 0; i < readers; i++ ) pthread_join(threads[i], NULL);
+        pthread_join(writerThread, NULL);
+        elapsed = benchmark_nowNs() - start;
+
+        printf("%s, %2ld readers: %.3f Mpasses/s (%u elements each)\n", useLock ? "rwlock" : "epoch ",
+               readers, (double)atomic_load(&passes) * 1e3 / (double)elapsed, BENCHMARK_ELEMENTS);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long maxReaders = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+
+    if( maxReaders < 1 ) maxReaders = 1;
+    if( maxReaders > (long)HLL_MAX_READERS ) maxReaders = HLL_MAX_READERS;
+
+    useLock = true;
+    readerScaling(maxReaders);
+    useLock = false;
+    readerScaling(maxReaders);
+    printf("checksum %u\n", atomic_load(&checksum));
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file benchmarkParallel.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief sum of a list with millions of elements, with the iterators and with
+ * heaplessList_parallelReduce from 0 (sequential) to N helper threads
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "heaplessListParallel.h"
+#include "benchmark.h"
+
+#if !defined(HLL_PARALLEL) || !defined(HLL_LARGE_CAPACITY)
+#error "build the benchmark with -DHLL_PARALLEL -DHLL_LARGE_CAPACITY"
+#endif
+
+#define BENCHMARK_LIST_SIZE 2000000u
+#define BENCHMARK_PASSES 20u
+
+static tIndex allocationArray[BENCHMARK_LIST_SIZE];
+static heaplessListNode nodes[BENCHMARK_LIST_SIZE];
+static uint32_t liveBitmap[HLL_LIVE_BITMAP_WORDS(BENCHMARK_LIST_SIZE)];
+static heaplessList list;
+static heaplessParallelPool pool;
+
+static tListReduce sum(tListReduce accumulator, tListData data, void* context)
+{
+    (void)context;
+    return accumulator + data;
+}
+
+static tListReduce add(tListReduce a, tListReduce b)
+{
+    return a + b;
+}
+
+int main(int argc, char** argv)
+{
+    long maxHelpers = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    long helpers;
+    uint32_t i;
+    uint32_t pass;
+    uint64_t start;
+    uint64_t elapsed;
+    tListReduce result = 0u;
+    heaplessListNode* n;
+
+    if( maxHelpers < 0 ) maxHelpers = 0;
+    if( maxHelpers > (long)HLL_PARALLEL_MAX_THREADS ) maxHelpers = HLL_PARALLEL_MAX_THREADS;
+
+    // 3 of each 4 nodes in the list, so the bitmap has holes
+    heaplessList_init(&list, allocationArray, nodes, BENCHMARK_LIST_SIZE);
+    heaplessList_initLiveBitmap(&list, liveBitmap);
+    while( heaplessList_append(&list, (tListData)heaplessList_size(&list)) );
+    n = heaplessList_initIt(&list);
+    for( i = 0; NULL != n; i++ ){
+        if( 0u == i % 4u ) (void)heaplessList_removeAndNextIt(&list, &n);
+        else if( !heaplessList_nextIt(&list, &n) ) break;
+    }
+
+    start = benchmark_nowNs();
+    for( pass = 0; pass < BENCHMARK_PASSES; pass++ ){
+        result = 0u;
+        for( n = heaplessList_initIt(&list); NULL != n; ){
+            result += heaplessList_getItData(n);
+            if( !heaplessList_nextIt(&list, &n) ) break;
+        }
+    }
+    elapsed = benchmark_nowNs() - start;
+    printf("iterators:           %.2f ms per pass, sum %u\n", (double)elapsed / BENCHMARK_PASSES / 1e6, result);
+
+    for( helpers = 0; helpers <= maxHelpers; helpers++ ){
+        (void)heaplessParallelPool_init(&pool, (tIndex)helpers);
+        start = benchmark_nowNs();
+        for( pass = 0; pass < BENCHMARK_PASSES; pass++ ){
+            result = heaplessList_parallelReduce(&list, &pool, 0u, sum, add, NULL);
+        }
+        elapsed = benchmark_nowNs() - start;
+        heaplessParallelPool_shutdown(&pool);
+        printf("parallel, %2ld helpers: %.2f ms per pass, sum %u\n", helpers, (double)elapsed / BENCHMARK_PASSES / 1e6, result);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file benchmarkPoolResource.cpp
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief std::pmr::list and std::pmr::map used as queues and as an index
+ * (insert and erase all the time), with the nodes from the default resource (new/delete)
+ * and from heapless::pool_resource
+ */
+
+#include <cstdio>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include "heaplessPoolResource.hpp"
+#include "benchmark.h"
+
+#define BENCHMARK_ELEMENTS 1000u
+#define BENCHMARK_OPERATIONS 10000000u
+#define BENCHMARK_BLOCK_SIZE 64u // bigger than the nodes of list<uint32_t> and map<uint32_t,uint32_t>
+
+alignas(std::max_align_t) static unsigned char poolMemory[BENCHMARK_ELEMENTS * BENCHMARK_BLOCK_SIZE];
+static tIndex poolFreeSlots[BENCHMARK_ELEMENTS];
+
+static void listQueue(const char* name, std::pmr::memory_resource* resource)
+{
+    std::pmr::list<uint32_t> l(resource);
+    uint32_t checksum = 0u;
+    uint64_t start;
+    uint64_t elapsed;
+
+    for( uint32_t i = 0; i < BENCHMARK_ELEMENTS; i++ ) l.push_back(i);
+
+    start = benchmark_nowNs();
+    for( uint32_t i = 0; i < BENCHMARK_OPERATIONS; i++ ){
+        checksum += l.front();
+        l.pop_front();
+        l.push_back(i);
+    }
+    elapsed = benchmark_nowNs() - start;
+
+    printf("pmr::list %-13s: %.2f ns per pop+push, checksum %u\n", name,
+           (double)elapsed / BENCHMARK_OPERATIONS, checksum);
+}
+
+static void mapIndex(const char* name, std::pmr::memory_resource* resource)
+{
+    std::pmr::map<uint32_t, uint32_t> m(resource);
+    uint32_t state = 1u;
+    uint32_t key;
+    uint32_t checksum = 0u;
+    uint64_t start;
+    uint64_t elapsed;
+
+    for( uint32_t i = 0; i < BENCHMARK_ELEMENTS; i++ ) m[benchmark_random(&state)] = i;
+
+    start = benchmark_nowNs();
+    for( uint32_t i = 0; i < BENCHMARK_OPERATIONS / 10u; i++ ){
+        auto it = m.lower_bound( benchmark_random(&state) ); // erase a random element
+        if( m.end() == it ) it = m.begin();
+        checksum += it->second;
+        m.erase(it);
+        key = benchmark_random(&state);
+        while( !m.emplace(key, i).second ) key++;
+    }
+    elapsed = benchmark_nowNs() - start;
+
+    printf("pmr::map  %-13s: %.2f ns per erase+insert, checksum %u\n", name,
+           (double)elapsed / (BENCHMARK_OPERATIONS / 10u), checksum);
+}
+
+int main(void)
+{
+    heapless::pool_resource pool(poolMemory, BENCHMARK_BLOCK_SIZE, BENCHMARK_ELEMENTS, poolFreeSlots);
+
+    listQueue("new/delete", std::pmr::new_delete_resource());
+    listQueue("heapless pool", &pool);
+    mapIndex("new/delete", std::pmr::new_delete_resource());
+    mapIndex("heapless pool", &pool);
+
+    printf("pool high water mark %u of %u blocks, %zu upstream allocations\n",
+           (unsigned)pool.high_water_mark(), (unsigned)pool.capacity(), pool.upstream_allocations());
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file benchmarkWorkQueue.c
+ * @author Tiago Lobao (tiago.blobao@gmail.com)
+ * @brief task throughput of heaplessWorkQueue from 1 to N workers.
+ * The work is a tree of tasks that starts in the worker 0, so the other workers must steal it
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "heaplessWorkQueue.h"
+#include "benchmark.h"
+
+#define BENCHMARK_MAX_WORKERS 64
+#define BENCHMARK_DEQUE_SIZE 1024
+#define BENCHMARK_TREE_DEPTH 20u
+#define BENCHMARK_TASK_SPIN 200u
+
+static heaplessWorkDeque deques[BENCHMARK_MAX_WORKERS];
+static heaplessWorkItem tasks[BENCHMARK_MAX_WORKERS * BENCHMARK_DEQUE_SIZE];
+static heaplessWorkQueue wq;
+static _Atomic uint32_t checksum;
+
+/**
+ * @brief each task spins a little and creates two children until the tree depth
+ */
+static void treeTask(heaplessWorkQueue* q, tIndex worker, tListData depth)
+{
+    volatile uint32_t spin = 0u;
+    uint32_t i;
+
+    for( i = 0; i < BENCHMARK_TASK_SPIN; i++ ) spin += i;
+    atomic_fetch_add_explicit(&checksum, 1u, memory_order_relaxed);
+
+    if( depth > 0u ){
+        if( !heaplessWorkQueue_push(q, worker, (tListData)(depth - 1u)) ) treeTask(q, worker, (tListData)(depth - 1u));
+        if( !heaplessWorkQueue_push(q, worker, (tListData)(depth - 1u)) ) treeTask(q, worker, (tListData)(depth - 1u));
+    }
+}
+
+static void* worker(void* arg)
+{
+    heaplessWorkQueue_run(&wq, (tIndex)(uintptr_t)arg, treeTask);
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    pthread_t threads[BENCHMARK_MAX_WORKERS];
+    long maxWorkers = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+    long workers;
+    long i;
+    uint64_t start;
+    uint64_t elapsed;
+
+    if( maxWorkers < 1 ) maxWorkers = 1;
+    if( maxWorkers > BENCHMARK_MAX_WORKERS ) maxWorkers = BENCHMARK_MAX_WORKERS;
+
+    for( workers = 1; workers <= maxWorkers; workers++ ){
+        heaplessWorkQueue_init(&wq, deques, tasks, (tIndex)workers, BENCHMARK_DEQUE_SIZE);
+        atomic_store(&checksum, 0u);
+        (void)heaplessWorkQueue_push(&wq, 0u, BENCHMARK_TREE_DEPTH);
+
+        start = benchmark_nowNs();
+        for( i = 1; i < workers; i++ ) pthread_create(&threads[i], NULL, worker, (void*)(uintptr_t)i);
+        worker((void*)0);
+        for( i = 1; i < workers; i++ ) pthread_join(threads[i], NULL);
+        elapsed = benchmark_nowNs() - start;
+
+        printf("work queue, %2ld workers: %u tasks, %.2f Mtasks/s\n",
+               workers, atomic_load(&checksum), (double)atomic_load(&checksum) * 1e3 / (double)elapsed);
+    }
+    return 0;
+}
@@ -1,15 +1,97 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
 #include "heaplessLinkedList.h"
 #include "ringBuffer.h"
+#include "heaplessTimerWheel.h"
+#include "heaplessWorkQueue.h"
+#include "heaplessBlockingQueue.h"
+#include "heaplessPriorityList.h"
+#include "heaplessListParallel.h"
+#include "heaplessIntrusiveList.h"
+#include "heaplessBTree.h"
 
 #define HEAPLESS_LIST_MAX_SIZE 20
 
+// the tests look inside the list, and the ends are kept differently in sentinel mode
+#ifdef HLL_SENTINEL_NODE
+#define LIST_END(l) ((l)->sentinelIndex)
+#define FIRST_NODE_INDEX(l) ((l)->linkedList[(l)->sentinelIndex].nextNode)
+#define LAST_NODE_INDEX(l) ((l)->linkedList[(l)->sentinelIndex].previousNode)
+#else
+#define LIST_END(l) HLL_NULL
+#define FIRST_NODE_INDEX(l) ((l)->firstNodeIndex)
+#define LAST_NODE_INDEX(l) ((l)->lastNodeIndex)
+#endif
+
 static tIndex ringBufferArray[HEAPLESS_LIST_MAX_SIZE];
+static tIndex recordArray[8]; // tIndex array, so the records are aligned
 
 static tIndex allocationArray[HEAPLESS_LIST_MAX_SIZE];
 static heaplessListNode heapMemory[HEAPLESS_LIST_MAX_SIZE];
 
+#ifdef HLL_LARGE_CAPACITY
+#define LARGE_LIST_SIZE 70000u // more than the 16 bits indexes can address
+static tIndex largeAllocationArray[LARGE_LIST_SIZE];
+static heaplessListNode largeMemory[LARGE_LIST_SIZE];
+#endif
+
+#ifdef HLL_SEGMENTED
+static heaplessListNode segmentMemory[2][HEAPLESS_LIST_MAX_SIZE];
+#endif
+
+#ifdef HLL_EPOCH_READERS
+#define EPOCH_READERS 2
+#define EPOCH_WRITES 20000
+static heaplessList epochList;
+static atomic_bool epochWriterDone;
+static bool epochReaderOk[EPOCH_READERS];
+#endif
+
+#ifdef HLL_PARALLEL
+#define PARALLEL_LIST_SIZE 20000u // more than one chunk, so the helpers have work
+static tIndex parallelAllocationArray[PARALLEL_LIST_SIZE];
+static heaplessListNode parallelMemory[PARALLEL_LIST_SIZE];
+static uint32_t parallelBitmap[HLL_LIVE_BITMAP_WORDS(PARALLEL_LIST_SIZE)];
+static uint32_t smallBitmap[HLL_LIVE_BITMAP_WORDS(HEAPLESS_LIST_MAX_SIZE)];
+#endif
+
+// record bigger than tListData, the link is in the middle of it
+typedef struct{
+    uint32_t id;
+    heaplessListLink link;
+    char name[16];
+} intrusiveRecord;
+static tIndex intrusiveAllocationArray[HEAPLESS_LIST_MAX_SIZE];
+static intrusiveRecord intrusiveRecords[HEAPLESS_LIST_MAX_SIZE];
+
+#define BTREE_SIZE 128u
+#define BTREE_KEYS 600u // enough for 3 levels of nodes
+static tIndex btreeAllocationArray[BTREE_SIZE];
+static heaplessBTreeNode btreeMemory[BTREE_SIZE];
+static bool btreeReference[BTREE_KEYS]; // keys that should be in the tree, the data is always 3 * key
+
+static tIndex timerAllocationArray[HEAPLESS_LIST_MAX_SIZE];
+static heaplessTimerNode timerMemory[HEAPLESS_LIST_MAX_SIZE];
+static tTimerTick timerExpiredAt[HEAPLESS_LIST_MAX_SIZE];
+static tTimerTick timerNow;
+
+#define WORK_QUEUE_WORKERS 4
+#define WORK_QUEUE_TASKS 1000
+static heaplessWorkDeque workDeques[WORK_QUEUE_WORKERS];
+static heaplessWorkItem workItems[WORK_QUEUE_WORKERS * HEAPLESS_LIST_MAX_SIZE];
+static heaplessWorkQueue workQueue;
+static atomic_int workExecuted[WORK_QUEUE_TASKS];
+
+#define BLOCKING_QUEUE_ITEMS 500
+static tIndex blockingAllocationArray[HEAPLESS_LIST_MAX_SIZE];
+static heaplessListNode blockingMemory[HEAPLESS_LIST_MAX_SIZE];
+static heaplessBlockingQueue blockingQueue;
+
+static tIndex priorityAllocationArray[HEAPLESS_LIST_MAX_SIZE];
+static heaplessPriorityNode priorityMemory[HEAPLESS_LIST_MAX_SIZE];
+
 
 
 
@@ -22,14 +104,154 @@ int test(bool condition, char* message){
     return r;
 }
 
+#ifdef HLL_WATERMARKS
+static int watermarkEvents;
+static bool watermarkIsHigh;
+static tIndex watermarkSize;
+
+void watermarkReached(bool isHigh, tIndex size, void* context)
+{
+    (void)context;
+    watermarkEvents++;
+    watermarkIsHigh = isHigh;
+    watermarkSize = size;
+}
+#endif
+
+/**
+ * @brief the iterators go through the keys of the reference in order, in both directions
+ */
+bool btreeMatchesReference(heaplessBTree* t)
+{
+    heaplessBTreeIt it;
+    bool isOk = true;
+    uint32_t count = 0u;
+    tBTreeKey key;
+
+    for( key = 0u; key < BTREE_KEYS; key++ ) count += btreeReference[key] ? 1u : 0u;
+    isOk &= ( count == heaplessBTree_size(t) );
+
+    key = 0u;
+    if( heaplessBTree_initIt(t, &it) ){
+        do{
+            while( key < BTREE_KEYS && !btreeReference[key] ) key++;
+            isOk &= ( key == heaplessBTree_getItKey(t, &it) && (tListData)(3u * key) == heaplessBTree_getItData(t, &it) );
+            key++;
+            count--;
+        } while( heaplessBTree_nextIt(t, &it) );
+    }
+    isOk &= ( 0u == count );
+
+    if( heaplessBTree_initItEnd(t, &it) ){
+        do{
+            count++;
+        } while( heaplessBTree_previousIt(t, &it) );
+    }
+    return isOk && count == heaplessBTree_size(t);
+}
+
+void timerExpired(tIndex timer, tListData data)
+{
+    (void)timer;
+    timerExpiredAt[data] = timerNow;
+}
+
+// every task up to WORK_QUEUE_TASKS/2 creates a new one, so the workers push while others steal
+void workHandler(heaplessWorkQueue* wq, tIndex worker, tListData task)
+{
+    atomic_fetch_add(&workExecuted[task], 1);
+    if( task < WORK_QUEUE_TASKS / 2 ){
+        if( !heaplessWorkQueue_push(wq, worker, task + WORK_QUEUE_TASKS / 2) )
+            workHandler(wq, worker, task + WORK_QUEUE_TASKS / 2);
+    }
+}
+
+void* workThread(void* arg)
+{
+    heaplessWorkQueue_run(&workQueue, (tIndex)(uintptr_t)arg, workHandler);
+    return NULL;
+}
+
+// consumer that only waits, the sum of the data is checked by the producer
+void* blockingConsumer(void* arg)
+{
+    tListData data;
+    int i;
+    int* sum = (int*)arg;
+
+    for( i = 0; i < BLOCKING_QUEUE_ITEMS; i++ ){
+        if( heaplessBlockingQueue_popWait(&blockingQueue, &data, HLL_WAIT_FOREVER) ) *sum += data;
+    }
+    return NULL;
+}
+
+#ifdef HLL_EPOCH_READERS
+// iterates without locks while the main thread removes the first element and appends a bigger one,
+// every pass must see increasing data and end before the capacity of the list
+void* epochReader(void* arg)
+{
+    tIndex reader = (tIndex)(uintptr_t)arg;
+    heaplessListNode* n;
+    tListData previous;
+    int visited;
+    bool isOk = true;
+
+    while( !atomic_load(&epochWriterDone) ){
+        heaplessList_readBegin(&epochList, reader);
+        n = heaplessList_initIt(&epochList);
+        previous = heaplessList_getItData(n);
+        visited = 1;
+        while( heaplessList_nextIt(&epochList, &n) ){
+            isOk &= ( heaplessList_getItData(n) > previous ) && ( visited < HEAPLESS_LIST_MAX_SIZE );
+            previous = heaplessList_getItData(n);
+            visited++;
+        }
+        heaplessList_readEnd(&epochList, reader);
+    }
+    epochReaderOk[reader] = isOk;
+    return NULL;
+}
+#endif
+
+#ifdef HLL_PARALLEL
+void parallelIncrement(tListData* data, void* context)
+{
+    *data += *(tListData*)context;
+}
+
+tListReduce parallelSum(tListReduce accumulator, tListData data, void* context)
+{
+    (void)context;
+    return accumulator + data;
+}
+
+tListReduce parallelAdd(tListReduce a, tListReduce b)
+{
+    return a + b;
+}
+
+// sum with the iterators, to compare with the parallel passes
+tListReduce iteratorSum(heaplessList* l)
+{
+    tListReduce sum = 0u;
+    heaplessListNode* n;
+
+    for( n = heaplessList_initIt(l); NULL_PTR != n; ){
+        sum += heaplessList_getItData(n);
+        if( !heaplessList_nextIt(l, &n) ) break;
+    }
+    return sum;
+}
+#endif
+
 void printlist(heaplessList* l)
 {
     tIndex j;
 
-    if( l->firstNodeIndex != HLL_NULL ){
+    if( FIRST_NODE_INDEX(l) != LIST_END(l) ){
         printf("heapless list -> ");
-        j  = l->firstNodeIndex;
-        while(j != HLL_NULL){
+        j  = FIRST_NODE_INDEX(l);
+        while(j != LIST_END(l)){
             printf("%d ", l->linkedList[j].data);
             j = l->linkedList[j].nextNode;
         }
@@ -109,8 +331,8 @@ int main(void)
                 my_rb.headIndex == my_rb.lenght &&
                 my_rb.tailIndex == 0 &&
                 my_rb.buffer[my_rb.tailIndex] == 0x20 &&
-                my_rb.buffer[my_rb.headIndex - 1] == count-2 &&
-                my_rb.lenght == (count+1)
+                my_rb.buffer[my_rb.headIndex - 1] == (tIndex)(count-2) &&
+                my_rb.lenght == (tIndex)(count+1)
             ),
             "Ring Buffer - 2.3 fill list till it has one free space" 
         );
@@ -180,7 +402,7 @@ int main(void)
                 my_rb.headIndex == 0u &&
                 my_rb.tailIndex == HEAPLESS_LIST_MAX_SIZE - my_rb.lenght &&
                 previousData == popedData &&
-                my_rb.lenght == count - 1
+                my_rb.lenght == (tIndex)(count - 1)
             ),
             "Ring Buffer - 3.2 pops until there is only one element left" 
         );
@@ -260,6 +482,198 @@ int main(void)
         "Ring Buffer - 4.3 Ring buffer indexes in the end and beggining of the array"
     );
 
+    //ringBuffer_popLastData
+    // ---------------------------------------------------------
+    ringBuffer_init(&my_rb, ringBufferArray, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = ringBuffer_addData(&my_rb, 0x20);
+    functionReturn = ringBuffer_addData(&my_rb, 0x31);
+    popedData = ringBuffer_popLastData(&my_rb);
+    testResults |= test(
+        (
+            popedData == 0x31 &&
+            my_rb.headIndex == 1u &&
+            my_rb.lenght == 1u
+        ),
+        "Ring Buffer - 5.1 pops the last added element"
+    );
+
+    // ---------------------------------------------------------
+    popedData = ringBuffer_popData(&my_rb);
+    functionReturn = ringBuffer_addData(&my_rb, 0x45); // head goes to 2
+    while( ringBuffer_popData(&my_rb) != HLL_NULL );
+    for( count = 0; count < HEAPLESS_LIST_MAX_SIZE - 2; count++ ) (void)ringBuffer_addData(&my_rb, count);
+    popedData = ringBuffer_popLastData(&my_rb); // head was 0, goes back to the end of the array
+    testResults |= test(
+        (
+            popedData == HEAPLESS_LIST_MAX_SIZE - 3 &&
+            my_rb.headIndex == HEAPLESS_LIST_MAX_SIZE - 1 &&
+            my_rb.lenght == HEAPLESS_LIST_MAX_SIZE - 3
+        ),
+        "Ring Buffer - 5.2 pops the last added element when the head is in the beggining"
+    );
+
+    popedData = ringBuffer_popLastData(&my_rb);
+    while( ringBuffer_popLastData(&my_rb) != HLL_NULL );
+    testResults |= test(
+        (
+            popedData == HEAPLESS_LIST_MAX_SIZE - 4 &&
+            my_rb.lenght == 0u &&
+            ringBuffer_popLastData(&my_rb) == HLL_NULL
+        ),
+        "Ring Buffer - 5.3 there is no elements left"
+    );
+
+    //ringBuffer_addN, ringBuffer_popN, ringBuffer_peekN
+    // ---------------------------------------------------------
+    tIndex my_block[HEAPLESS_LIST_MAX_SIZE + 5];
+    tIndex my_output[HEAPLESS_LIST_MAX_SIZE + 5];
+    tIndex my_count;
+
+    for( count = 0; count < HEAPLESS_LIST_MAX_SIZE + 5; count++ ) my_block[count] = (tIndex)(100 + count);
+    ringBuffer_init(&my_rb, ringBufferArray, HEAPLESS_LIST_MAX_SIZE);
+    for( count = 0; count < 15; count++ ) (void)ringBuffer_addData(&my_rb, 0u);
+    for( count = 0; count < 15; count++ ) (void)ringBuffer_popData(&my_rb);
+
+    my_count = ringBuffer_addN(&my_rb, my_block, 10u); // goes around the end of the array
+    testResults |= test(
+        (
+            my_count == 10u &&
+            my_rb.lenght == 10u &&
+            my_rb.headIndex == 5u &&
+            my_rb.buffer[19] == 104u &&
+            my_rb.buffer[0] == 105u
+        ),
+        "Ring Buffer - 6.1 add a block around the end of the array"
+    );
+
+    // ---------------------------------------------------------
+    my_count = ringBuffer_peekN(&my_rb, my_output, 7u);
+    testResults |= test(
+        (
+            my_count == 7u &&
+            my_rb.lenght == 10u &&
+            my_output[0] == 100u &&
+            my_output[6] == 106u
+        ),
+        "Ring Buffer - 6.2 peek a block without removing it"
+    );
+
+    // ---------------------------------------------------------
+    my_count = ringBuffer_addN(&my_rb, my_block, HEAPLESS_LIST_MAX_SIZE + 5);
+    testResults |= test(
+        (
+            my_count == HEAPLESS_LIST_MAX_SIZE - 10 &&
+            my_rb.lenght == HEAPLESS_LIST_MAX_SIZE &&
+            my_rb.headIndex == my_rb.tailIndex &&
+            ringBuffer_addN(&my_rb, my_block, 1u) == 0u
+        ),
+        "Ring Buffer - 6.3 add only what fits in the buffer"
+    );
+
+    // ---------------------------------------------------------
+    my_count = ringBuffer_popN(&my_rb, my_output, HEAPLESS_LIST_MAX_SIZE + 5);
+    functionReturn = true;
+    for( count = 0; count < 10; count++ ) functionReturn &= ( my_output[count] == (tIndex)(100 + count) );
+    for( ; count < HEAPLESS_LIST_MAX_SIZE; count++ ) functionReturn &= ( my_output[count] == (tIndex)(100 + count - 10) );
+    testResults |= test(
+        (
+            functionReturn == true &&
+            my_count == HEAPLESS_LIST_MAX_SIZE &&
+            my_rb.lenght == 0u &&
+            my_rb.tailIndex == my_rb.headIndex &&
+            ringBuffer_popN(&my_rb, my_output, 1u) == 0u
+        ),
+        "Ring Buffer - 6.4 pop all the elements in order"
+    );
+
+    //ringBuffer_reserve, ringBuffer_commit, ringBuffer_peek, ringBuffer_release
+    // ---------------------------------------------------------
+    const tIndex H = RING_BUFFER_RECORD_HEADER;
+    ringBufferBytes my_rbb;
+    uint8_t* my_bytes = (uint8_t*)recordArray;
+    uint8_t* my_record;
+    tIndex my_len;
+
+    ringBuffer_initBytes(&my_rbb, my_bytes, (tIndex)sizeof(recordArray));
+    my_record = ringBuffer_reserve(&my_rbb, 3u * H);
+    if( NULL_PTR != my_record ) memset(my_record, 0xA1, 2u * H);
+    testResults |= test(
+        (
+            my_record == my_bytes + H &&
+            ringBuffer_peek(&my_rbb, &my_len) == NULL_PTR &&
+            ringBuffer_commit(&my_rbb, 4u * H) == false &&
+            ringBuffer_commit(&my_rbb, 2u * H) == true &&
+            ringBuffer_commit(&my_rbb, 2u * H) == false &&
+            my_rbb.headIndex == 3u * H &&
+            my_rbb.lenght == 3u * H
+        ),
+        "Ring Buffer - 7.1 reserve and commit less than reserved"
+    );
+
+    // ---------------------------------------------------------
+    my_record = ringBuffer_reserve(&my_rbb, 2u * H);
+    if( NULL_PTR != my_record ) memset(my_record, 0xB2, 2u * H);
+    functionReturn = ringBuffer_commit(&my_rbb, 2u * H);
+    my_record = ringBuffer_peek(&my_rbb, &my_len);
+    testResults |= test(
+        (
+            functionReturn == true &&
+            my_record == my_bytes + H &&
+            my_len == 2u * H &&
+            my_record[0] == 0xA1 && my_record[2u * H - 1u] == 0xA1 &&
+            ringBuffer_release(&my_rbb) == true &&
+            my_rbb.tailIndex == 3u * H &&
+            my_rbb.lenght == 3u * H
+        ),
+        "Ring Buffer - 7.2 peek and release the oldest record"
+    );
+
+    // ---------------------------------------------------------
+    my_record = ringBuffer_reserve(&my_rbb, 2u * H); // 2H in the end, goes to the beginning
+    if( NULL_PTR != my_record ) memset(my_record, 0xC3, H);
+    testResults |= test(
+        (
+            ringBuffer_reserve(&my_rbb, 3u * H) == NULL_PTR &&
+            ringBuffer_reserve(&my_rbb, 2u * H) == my_bytes + H &&
+            my_record == my_bytes + H &&
+            ringBuffer_commit(&my_rbb, H) == true &&
+            my_rbb.headIndex == 2u * H &&
+            my_rbb.lenght == 7u * H &&
+            ringBuffer_reserve(&my_rbb, 1u) == NULL_PTR
+        ),
+        "Ring Buffer - 7.3 record that does not fit in the end goes to the beginning"
+    );
+
+    // ---------------------------------------------------------
+    my_record = ringBuffer_peek(&my_rbb, &my_len);
+    functionReturn = ( NULL_PTR != my_record && my_len == 2u * H && my_record[0] == 0xB2 );
+    functionReturn &= ringBuffer_release(&my_rbb);
+    testResults |= test(
+        (
+            functionReturn == true &&
+            my_rbb.tailIndex == 0u &&
+            my_rbb.lenght == 2u * H &&
+            ringBuffer_peek(&my_rbb, &my_len) == my_bytes + H &&
+            my_len == H &&
+            my_bytes[H] == 0xC3
+        ),
+        "Ring Buffer - 7.4 the consumer skips the end of the buffer"
+    );
+
+    // ---------------------------------------------------------
+    functionReturn = ringBuffer_release(&my_rbb);
+    testResults |= test(
+        (
+            functionReturn == true &&
+            my_rbb.lenght == 0u &&
+            ringBuffer_peek(&my_rbb, &my_len) == NULL_PTR &&
+            ringBuffer_release(&my_rbb) == false &&
+            ringBuffer_reserve(&my_rbb, 7u * H) == my_bytes + H &&
+            ringBuffer_reserve(&my_rbb, 7u * H + 1u) == NULL_PTR
+        ),
+        "Ring Buffer - 7.5 empty buffer gives all the space to one record"
+    );
+
 
 
 
@@ -274,8 +688,8 @@ int main(void)
     heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
     testResults |= test(
         (
-            my_l.firstNodeIndex == HLL_NULL &&
-            my_l.lastNodeIndex == HLL_NULL
+            FIRST_NODE_INDEX(&my_l) == LIST_END(&my_l) &&
+            LAST_NODE_INDEX(&my_l) == LIST_END(&my_l)
         ),
         "HeaplessList - 1. Init List"
     );
@@ -286,8 +700,8 @@ int main(void)
     testResults |= test(
         (
             functionReturn == true &&
-            my_l.firstNodeIndex == my_l.lastNodeIndex &&
-            my_l.firstNodeIndex != HLL_NULL
+            FIRST_NODE_INDEX(&my_l) == LAST_NODE_INDEX(&my_l) &&
+            FIRST_NODE_INDEX(&my_l) != LIST_END(&my_l)
         ),
         "HeaplessList - 2.1 Add first element to the list"
     );
@@ -354,7 +768,7 @@ int main(void)
     // bool heaplessList_removeLast(heaplessList* l);
     // ---------------------------------------------------------
     testResults |= test(
-        (my_l.linkedList[my_l.lastNodeIndex].data == 224 &&
+        (my_l.linkedList[LAST_NODE_INDEX(&my_l)].data == 224 &&
         functionReturn == true),
         "HeaplessList - 5.0 check previous state"
     );
@@ -362,7 +776,7 @@ int main(void)
     // ---------------------------------------------------------
     functionReturn = heaplessList_removeLast(&my_l);
     testResults |= test(
-        (my_l.linkedList[my_l.lastNodeIndex].data == 225 &&
+        (my_l.linkedList[LAST_NODE_INDEX(&my_l)].data == 225 &&
         functionReturn == true),
         "HeaplessList - 5.1 remove last element (without getting it)"
     );
@@ -423,6 +837,14 @@ int main(void)
         "HeaplessList - 7.4 Iterate the list backwards (no change because it was the beggining)"
     );
 
+    // ---------------------------------------------------------
+    my_n = NULL_PTR; // what heaplessList_initIt gives for an empty list
+    functionReturn = heaplessList_nextIt(&my_l, &my_n) || heaplessList_previousIt(&my_l, &my_n);
+    testResults |= test(
+            my_n == NULL_PTR && functionReturn == false,
+        "HeaplessList - 7.5 Iterate with a NULL iterator"
+    );
+
 
 // ---------------------------------------------------------
 // ---------------------------------------------------------
@@ -505,6 +927,835 @@ int main(void)
 
     heaplessList_append(&my_l, 200u);
 
+#ifdef HLL_LARGE_CAPACITY
+    // ---------------------------------------------------------
+    heaplessList my_largeList;
+    heaplessList_init(&my_largeList, largeAllocationArray, largeMemory, LARGE_LIST_SIZE);
+    count = 0;
+    while( heaplessList_append(&my_largeList, (tListData)count) ) count++;
+    testResults |= test( count >= (int)LARGE_LIST_SIZE - 1 && HLL_NULL == 0xFFFFFFFFu,
+            "HeaplessList - 9.8 list with more than 65534 elements");
+
+    functionReturn = true;
+    for( count = 0; heaplessList_pop(&my_largeList, &my_data); count++ ){
+        functionReturn &= ( my_data == (tListData)count );
+    }
+    testResults |= test( functionReturn == true && count >= (int)LARGE_LIST_SIZE - 1,
+            "HeaplessList - 9.9 pop all the elements of the large list in order");
+#endif
+
+#ifdef HLL_SEGMENTED
+    // bool heaplessList_addSegment(heaplessList* l, heaplessListNode* nodes, tIndex count);
+    // ---------------------------------------------------------
+    functionReturn = heaplessList_append(&my_l, 300u);
+    testResults |= test( functionReturn == false,
+            "HeaplessList - 10.1 list is full before adding a segment");
+
+    my_n = heaplessList_initIt(&my_l); // iterator created before the new nodes
+    my_data = heaplessList_getItData(my_n);
+    functionReturn = heaplessList_addSegment(&my_l, segmentMemory[0], HEAPLESS_LIST_MAX_SIZE);
+    functionReturn &= heaplessList_addSegment(&my_l, segmentMemory[1], HEAPLESS_LIST_MAX_SIZE);
+    testResults |= test( functionReturn == true,
+            "HeaplessList - 10.2 add two segments to a full list");
+
+    count = 0;
+    while( heaplessList_append(&my_l, 300u + count) ) count++;
+    testResults |= test( count == 2 * HEAPLESS_LIST_MAX_SIZE && heaplessList_getItData(my_n) == my_data,
+            "HeaplessList - 10.3 the segments are used and the old iterator keeps valid");
+
+    count = 0;
+    while( heaplessList_nextIt(&my_l, &my_n) ){
+        if( heaplessList_getItData(my_n) >= 300u ) count++;
+    }
+    testResults |= test( count == 2 * HEAPLESS_LIST_MAX_SIZE && heaplessList_getItData(my_n) == 300u + count - 1,
+            "HeaplessList - 10.4 iterate from the first array to the segments");
+
+    // bool heaplessList_releaseSegment(heaplessList* l, heaplessListNode* nodes);
+    // ---------------------------------------------------------
+    functionReturn = heaplessList_releaseSegment(&my_l, segmentMemory[1]);
+    testResults |= test( functionReturn == false,
+            "HeaplessList - 10.5 segment in use can not be released");
+
+    // remove the last elements (the ones of the second segment)
+    for( count = 0; count < HEAPLESS_LIST_MAX_SIZE; count++ ){
+        (void)heaplessList_removeLast(&my_l);
+    }
+    functionReturn = heaplessList_releaseSegment(&my_l, segmentMemory[1]);
+    testResults |= test( functionReturn == true && heaplessList_getItData(heaplessList_initItEnd(&my_l)) == 300u + HEAPLESS_LIST_MAX_SIZE - 1,
+            "HeaplessList - 10.6 free segment is released");
+
+    functionReturn = heaplessList_append(&my_l, 400u);
+    testResults |= test( functionReturn == false,
+            "HeaplessList - 10.7 released segment is not used anymore");
+
+    while( heaplessList_removeFirst(&my_l) );
+    functionReturn = heaplessList_releaseSegment(&my_l, segmentMemory[0]);
+    testResults |= test( functionReturn == true && my_l.allocationTable.lenght == my_l.segments[0].length - (LIST_END(&my_l) != HLL_NULL),
+            "HeaplessList - 10.8 empty list releases all the segments");
+#endif
+
+#ifdef HLL_STABLE_HANDLES
+    // bool heaplessList_appendWithHandle(heaplessList* l, tListData data, heaplessListHandle* handle);
+    // ---------------------------------------------------------
+    heaplessListHandle my_h[3];
+    heaplessListHandle my_lastHandle;
+
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = true;
+    for( count = 0; count < 3; count++ ){
+        functionReturn &= heaplessList_appendWithHandle(&my_l, (tListData)(10u + count), &my_h[count]);
+    }
+    testResults |= test( functionReturn == true && heaplessList_getItData(heaplessList_resolve(&my_l, my_h[1])) == 11u,
+            "HeaplessList - 11.1 resolve the handle of an element");
+
+    // bool heaplessList_removeByHandle(heaplessList* l, heaplessListHandle handle);
+    // ---------------------------------------------------------
+    functionReturn = heaplessList_removeByHandle(&my_l, my_h[1]);
+    my_n = heaplessList_initIt(&my_l);
+    (void)heaplessList_nextIt(&my_l, &my_n);
+    testResults |= test( functionReturn == true && heaplessList_resolve(&my_l, my_h[1]) == NULL_PTR &&
+                         heaplessList_removeByHandle(&my_l, my_h[1]) == false && heaplessList_getItData(my_n) == 12u,
+            "HeaplessList - 11.2 remove an element in the middle by its handle");
+
+    // the node of the removed element is used again
+    count = 100;
+    while( heaplessList_append(&my_l, count) ) count++;
+    testResults |= test( heaplessList_resolve(&my_l, my_h[1]) == NULL_PTR &&
+                         heaplessList_getItData(heaplessList_resolve(&my_l, my_h[2])) == 12u,
+            "HeaplessList - 11.3 handle is stale after its node is reused");
+
+    // ---------------------------------------------------------
+    my_lastHandle = heaplessList_getHandle(&my_l, heaplessList_initItEnd(&my_l));
+    functionReturn = heaplessList_removeByHandle(&my_l, my_h[0]);
+    functionReturn &= heaplessList_removeByHandle(&my_l, my_lastHandle);
+    (void)heaplessList_getFirst(&my_l, &my_data);
+    testResults |= test( functionReturn == true && my_data == 12u &&
+                         heaplessList_getItData(heaplessList_initItEnd(&my_l)) == (tListData)(count - 2u),
+            "HeaplessList - 11.4 remove the first and the last elements by their handles");
+
+    // ---------------------------------------------------------
+    my_lastHandle = heaplessList_getHandle(&my_l, NULL_PTR);
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    testResults |= test( heaplessList_resolve(&my_l, my_lastHandle) == NULL_PTR &&
+                         heaplessList_resolve(&my_l, my_h[2]) == NULL_PTR,
+            "HeaplessList - 11.5 invalid handles and handles from before the init do not resolve");
+#endif
+
+#ifdef HLL_EPOCH_READERS
+    // bool heaplessList_readBegin(heaplessList* l, tIndex reader);
+    // ---------------------------------------------------------
+    pthread_t my_readers[EPOCH_READERS];
+
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    count = 1;
+    while( heaplessList_append(&my_l, count) ) count++;
+    heaplessList_readBegin(&my_l, 0u);
+    my_n = heaplessList_initIt(&my_l);
+    functionReturn = heaplessList_removeFirst(&my_l);
+    functionReturn &= !heaplessList_append(&my_l, 500u);
+    testResults |= test( functionReturn == true && heaplessList_getItData(my_n) == 1u &&
+                         heaplessList_nextIt(&my_l, &my_n) && heaplessList_getItData(my_n) == 2u,
+            "HeaplessList - 12.1 removed node is not reused while a reader may hold it");
+
+    // bool heaplessList_reclaim(heaplessList* l);
+    // ---------------------------------------------------------
+    heaplessList_readEnd(&my_l, 0u);
+    functionReturn = heaplessList_append(&my_l, 500u);
+    testResults |= test( functionReturn == true && heaplessList_getItData(heaplessList_initItEnd(&my_l)) == 500u &&
+                         heaplessList_reclaim(&my_l) == false,
+            "HeaplessList - 12.2 removed node is reused after the reader leaves");
+
+    // ---------------------------------------------------------
+    heaplessList_init(&epochList, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    for( count = 0; count < HEAPLESS_LIST_MAX_SIZE / 2; count++ ) (void)heaplessList_append(&epochList, count);
+    atomic_init(&epochWriterDone, false);
+    for( count = 0; count < EPOCH_READERS; count++ ){
+        pthread_create(&my_readers[count], NULL, epochReader, (void*)(uintptr_t)count);
+    }
+    functionReturn = true;
+    for( count = HEAPLESS_LIST_MAX_SIZE / 2; count < EPOCH_WRITES; count++ ){
+        functionReturn &= heaplessList_removeFirst(&epochList);
+        // the readers may still hold the removed nodes, so try again until they are reclaimed
+        while( !heaplessList_append(&epochList, count) ) sched_yield();
+    }
+    atomic_store(&epochWriterDone, true);
+    for( count = 0; count < EPOCH_READERS; count++ ){
+        pthread_join(my_readers[count], NULL);
+        functionReturn &= epochReaderOk[count];
+    }
+    testResults |= test( functionReturn == true,
+            "HeaplessList - 12.3 readers iterate without locks while the writer changes the list");
+
+    // ---------------------------------------------------------
+    testResults |= test( heaplessList_readBegin(&epochList, HLL_MAX_READERS) == false &&
+                         heaplessList_readEnd(&epochList, HLL_MAX_READERS) == false,
+            "HeaplessList - 12.4 reader id out of range");
+#endif
+
+#ifdef HLL_PARALLEL
+    // void heaplessList_parallelForEach(heaplessList* l, heaplessParallelPool* pool, ...);
+    // ---------------------------------------------------------
+    heaplessParallelPool my_pool;
+    tListData my_increment = 1u;
+    tListReduce my_reduce;
+
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    for( count = 0; count < 10; count++ ) (void)heaplessList_append(&my_l, count);
+    (void)heaplessList_removeFirst(&my_l);
+    heaplessList_initLiveBitmap(&my_l, smallBitmap); // list already in use
+    (void)heaplessList_removeLast(&my_l);
+    heaplessList_parallelForEach(&my_l, NULL_PTR, parallelIncrement, &my_increment);
+    (void)heaplessList_getFirst(&my_l, &my_data);
+    testResults |= test( my_data == 2u && heaplessList_getItData(heaplessList_initItEnd(&my_l)) == 9u && iteratorSum(&my_l) == 8u * 9u / 2u + 8u,
+            "HeaplessList - 13.1 sequential forEach changes only the elements in the list");
+
+    // tListReduce heaplessList_parallelReduce(heaplessList* l, heaplessParallelPool* pool, ...);
+    // ---------------------------------------------------------
+    functionReturn = heaplessParallelPool_init(&my_pool, 3u);
+    heaplessList_init(&my_l, parallelAllocationArray, parallelMemory, PARALLEL_LIST_SIZE);
+    heaplessList_initLiveBitmap(&my_l, parallelBitmap);
+    count = 0;
+    while( heaplessList_append(&my_l, (tListData)count) ) count++;
+    // holes in the node array
+    my_n = heaplessList_initIt(&my_l);
+    for( count = 0; NULL_PTR != my_n; count++ ){
+        if( 0 == count % 3 ) (void)heaplessList_removeAndNextIt(&my_l, &my_n);
+        else if( !heaplessList_nextIt(&my_l, &my_n) ) break;
+    }
+    my_reduce = heaplessList_parallelReduce(&my_l, &my_pool, 0u, parallelSum, parallelAdd, NULL_PTR);
+    testResults |= test( functionReturn == true && my_reduce == iteratorSum(&my_l) &&
+                         my_reduce == heaplessList_parallelReduce(&my_l, NULL_PTR, 0u, parallelSum, parallelAdd, NULL_PTR),
+            "HeaplessList - 13.2 parallel reduce skips the free nodes");
+
+    // ---------------------------------------------------------
+    my_increment = 3u;
+    heaplessList_parallelForEach(&my_l, &my_pool, parallelIncrement, &my_increment);
+    count = 0;
+    for( my_n = heaplessList_initIt(&my_l); heaplessList_nextIt(&my_l, &my_n); ) count++;
+    testResults |= test( iteratorSum(&my_l) == my_reduce + 3u * (tListReduce)(count + 1),
+            "HeaplessList - 13.3 parallel forEach visits every element once");
+
+    // ---------------------------------------------------------
+    while( heaplessList_removeFirst(&my_l) );
+    my_reduce = heaplessList_parallelReduce(&my_l, &my_pool, 0u, parallelSum, parallelAdd, NULL_PTR);
+    heaplessParallelPool_shutdown(&my_pool);
+    testResults |= test( my_reduce == 0u,
+            "HeaplessList - 13.4 reduce of an empty list is the identity");
+#endif
+
+    // tIndex heaplessList_size(heaplessList* l);
+    // ---------------------------------------------------------
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = ( heaplessList_size(&my_l) == 0u && !heaplessList_isFull(&my_l) );
+    count = 0;
+    while( heaplessList_append(&my_l, count) ) count++;
+    testResults |= test( functionReturn == true && heaplessList_size(&my_l) == (tIndex)count &&
+                         heaplessList_capacity(&my_l) == (tIndex)count && heaplessList_isFull(&my_l) &&
+                         count == HEAPLESS_LIST_MAX_SIZE - (LIST_END(&my_l) != HLL_NULL),
+            "HeaplessList - 14.1 size and capacity of a full list");
+
+    // ---------------------------------------------------------
+    my_n = heaplessList_initIt(&my_l);
+    (void)heaplessList_nextIt(&my_l, &my_n);
+    functionReturn = heaplessList_removeAndNextIt(&my_l, &my_n);
+    functionReturn &= heaplessList_removeFirst(&my_l) && heaplessList_removeLast(&my_l) && heaplessList_pop(&my_l, &my_data);
+    count = 0;
+    for( my_n = heaplessList_initIt(&my_l); NULL_PTR != my_n; ){
+        count++;
+        if( !heaplessList_nextIt(&my_l, &my_n) ) break;
+    }
+    testResults |= test( functionReturn == true && heaplessList_size(&my_l) == (tIndex)count &&
+                         heaplessList_size(&my_l) == heaplessList_capacity(&my_l) - 4u && !heaplessList_isFull(&my_l),
+            "HeaplessList - 14.2 size follows the removals");
+
+#ifdef HLL_SEGMENTED
+    // ---------------------------------------------------------
+    count = heaplessList_capacity(&my_l);
+    functionReturn = heaplessList_addSegment(&my_l, segmentMemory[0], HEAPLESS_LIST_MAX_SIZE);
+    functionReturn &= ( heaplessList_capacity(&my_l) == (tIndex)(count + HEAPLESS_LIST_MAX_SIZE) );
+    while( heaplessList_append(&my_l, 0u) );
+    functionReturn &= heaplessList_isFull(&my_l) && heaplessList_size(&my_l) == heaplessList_capacity(&my_l);
+    while( heaplessList_removeLast(&my_l) );
+    functionReturn &= heaplessList_releaseSegment(&my_l, segmentMemory[0]);
+    testResults |= test( functionReturn == true && heaplessList_capacity(&my_l) == (tIndex)count && heaplessList_size(&my_l) == 0u,
+            "HeaplessList - 14.3 capacity with the segments");
+#endif
+
+#ifdef HLL_EPOCH_READERS
+    // ---------------------------------------------------------
+    while( heaplessList_append(&my_l, 0u) );
+    heaplessList_readBegin(&my_l, 0u);
+    functionReturn = heaplessList_removeFirst(&my_l);
+    functionReturn &= !heaplessList_isFull(&my_l) && !heaplessList_append(&my_l, 0u); // the node waits for the reader
+    heaplessList_readEnd(&my_l, 0u);
+    testResults |= test( functionReturn == true && heaplessList_append(&my_l, 0u) && heaplessList_isFull(&my_l),
+            "HeaplessList - 14.4 removed nodes waiting for the readers are not counted");
+#endif
+
+#ifdef HLL_WATERMARKS
+    // bool heaplessList_setWatermarks(heaplessList* l, tIndex high, tIndex low, ...);
+    // ---------------------------------------------------------
+    heaplessList_init(&my_l, allocationArray, heapMemory, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = heaplessList_setWatermarks(&my_l, 15u, 5u, watermarkReached, &my_l);
+    for( count = 0; count < 15; count++ ) (void)heaplessList_append(&my_l, count);
+    functionReturn &= ( 1 == watermarkEvents && watermarkIsHigh && 15u == watermarkSize );
+    (void)heaplessList_append(&my_l, 15u);
+    while( heaplessList_size(&my_l) > 6u ) (void)heaplessList_removeFirst(&my_l);
+    testResults |= test( functionReturn == true && 1 == watermarkEvents,
+            "HeaplessList - 15.1 high watermark is reported once");
+
+    // ---------------------------------------------------------
+    (void)heaplessList_removeFirst(&my_l);
+    functionReturn = ( 2 == watermarkEvents && !watermarkIsHigh && 5u == watermarkSize );
+    while( heaplessList_size(&my_l) < 14u ) (void)heaplessList_append(&my_l, 0u);
+    functionReturn &= ( 2 == watermarkEvents );
+    (void)heaplessList_append(&my_l, 0u);
+    testResults |= test( functionReturn == true && 3 == watermarkEvents && watermarkIsHigh,
+            "HeaplessList - 15.2 low watermark is reported before the high one again");
+
+    // ---------------------------------------------------------
+    functionReturn = heaplessList_setWatermarks(&my_l, 10u, 2u, watermarkReached, &my_l); // already above
+    functionReturn &= ( 4 == watermarkEvents && watermarkIsHigh );
+    functionReturn &= heaplessList_setWatermarks(&my_l, 0u, 0u, NULL_PTR, NULL_PTR);
+    while( heaplessList_removeFirst(&my_l) );
+    testResults |= test( functionReturn == true && 4 == watermarkEvents,
+            "HeaplessList - 15.3 watermarks set above the high one, and disabled");
+#endif
+
+
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessTimerWheel ************************/
+    /*************************************************************************************/
+    heaplessTimerWheel my_tw;
+    tIndex my_timers[4];
+
+    // void heaplessTimerWheel_init(heaplessTimerWheel* tw, ...);
+    // ---------------------------------------------------------
+    heaplessTimerWheel_init(&my_tw, timerAllocationArray, timerMemory, HEAPLESS_LIST_MAX_SIZE);
+    testResults |= test(
+        (
+            my_tw.currentTick == 0u &&
+            my_tw.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE &&
+            my_tw.slotHead[0] == HLL_NULL
+        ),
+        "TimerWheel - 1. Init timer wheel"
+    );
+
+    // tIndex heaplessTimerWheel_schedule(heaplessTimerWheel* tw, tTimerTick delay, tListData data);
+    // tIndex heaplessTimerWheel_tick(heaplessTimerWheel* tw, heaplessTimerWheel_callback cb);
+    // ---------------------------------------------------------
+    for( count = 0; count < HEAPLESS_LIST_MAX_SIZE; count++ ) timerExpiredAt[count] = 0u;
+    my_timers[0] = heaplessTimerWheel_schedule(&my_tw, 5u, 0u);       // level 0
+    my_timers[1] = heaplessTimerWheel_schedule(&my_tw, 64u, 1u);      // level 1, first cascade
+    my_timers[2] = heaplessTimerWheel_schedule(&my_tw, 300u, 2u);     // level 1
+    my_timers[3] = heaplessTimerWheel_schedule(&my_tw, 5000u, 3u);    // level 2
+    (void)heaplessTimerWheel_schedule(&my_tw, 0u, 4u);                // handled as 1 tick
+    (void)heaplessTimerWheel_schedule(&my_tw, 20000000u, 5u);         // beyond the last level
+    testResults |= test(
+        (
+            my_timers[0] != HLL_NULL && my_timers[3] != HLL_NULL &&
+            my_tw.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE - 6
+        ),
+        "TimerWheel - 2.1 schedule timers in different levels"
+    );
+
+    count = 0;
+    for( timerNow = 1u; timerNow <= 5000u; timerNow++ ){
+        count += heaplessTimerWheel_tick(&my_tw, timerExpired);
+    }
+    testResults |= test(
+        (
+            count == 5 &&
+            timerExpiredAt[0] == 5u &&
+            timerExpiredAt[1] == 64u &&
+            timerExpiredAt[2] == 300u &&
+            timerExpiredAt[3] == 5000u &&
+            timerExpiredAt[4] == 1u &&
+            timerExpiredAt[5] == 0u
+        ),
+        "TimerWheel - 2.2 timers expire exactly on time after cascading"
+    );
+
+    for( ; timerNow <= 20005000u; timerNow++ ){
+        (void)heaplessTimerWheel_tick(&my_tw, timerExpired);
+    }
+    testResults |= test(
+        (
+            timerExpiredAt[5] == 20000000u &&
+            my_tw.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE
+        ),
+        "TimerWheel - 2.3 timer beyond the last level expires on time"
+    );
+
+    // bool heaplessTimerWheel_cancel(heaplessTimerWheel* tw, tIndex timer);
+    // ---------------------------------------------------------
+    timerExpiredAt[0] = 0u;
+    timerExpiredAt[1] = 0u;
+    my_timers[0] = heaplessTimerWheel_schedule(&my_tw, 100u, 0u);
+    my_timers[1] = heaplessTimerWheel_schedule(&my_tw, 100u, 1u);
+    functionReturn = heaplessTimerWheel_cancel(&my_tw, my_timers[0]);
+    testResults |= test(
+        functionReturn == true && my_tw.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE - 1,
+        "TimerWheel - 3.1 cancel a running timer"
+    );
+    functionReturn = heaplessTimerWheel_cancel(&my_tw, my_timers[0]);
+    testResults |= test(
+        functionReturn == false,
+        "TimerWheel - 3.2 cancel the same timer again is not possible"
+    );
+    for( count = 0; count < 100; count++, timerNow++ ){
+        (void)heaplessTimerWheel_tick(&my_tw, timerExpired);
+    }
+    testResults |= test(
+        (
+            timerExpiredAt[0] == 0u &&
+            timerExpiredAt[1] == timerNow - 1u &&
+            my_tw.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE
+        ),
+        "TimerWheel - 3.3 only the not cancelled timer expires"
+    );
+
+    // ---------------------------------------------------------
+    count = 0;
+    while( HLL_NULL != heaplessTimerWheel_schedule(&my_tw, 10u, 0u) ) count++;
+    testResults |= test(
+        count == HEAPLESS_LIST_MAX_SIZE,
+        "TimerWheel - 4.1 not possible to schedule more timers than the pool size"
+    );
+
+
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessWorkQueue *************************/
+    /*************************************************************************************/
+    tListData my_task;
+    pthread_t my_threads[WORK_QUEUE_WORKERS];
+
+    // void heaplessWorkQueue_init(heaplessWorkQueue* wq, ...);
+    // ---------------------------------------------------------
+    heaplessWorkQueue_init(&workQueue, workDeques, workItems, WORK_QUEUE_WORKERS, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = heaplessWorkQueue_pop(&workQueue, 0u, &my_task);
+    testResults |= test(
+        functionReturn == false && workQueue.pendingTasks == 0,
+        "WorkQueue - 1. Init work queue with empty deques"
+    );
+
+    // bool heaplessWorkQueue_push(heaplessWorkQueue* wq, tIndex worker, tListData task);
+    // bool heaplessWorkQueue_pop(heaplessWorkQueue* wq, tIndex worker, tListData* task);
+    // bool heaplessWorkQueue_steal(heaplessWorkQueue* wq, tIndex victim, tListData* task);
+    // ---------------------------------------------------------
+    (void)heaplessWorkQueue_push(&workQueue, 0u, 10u);
+    (void)heaplessWorkQueue_push(&workQueue, 0u, 11u);
+    (void)heaplessWorkQueue_push(&workQueue, 0u, 12u);
+    functionReturn = heaplessWorkQueue_pop(&workQueue, 0u, &my_task);
+    testResults |= test(
+        functionReturn == true && my_task == 12u,
+        "WorkQueue - 2.1 owner pops the newest task"
+    );
+    functionReturn = heaplessWorkQueue_steal(&workQueue, 0u, &my_task);
+    testResults |= test(
+        functionReturn == true && my_task == 10u,
+        "WorkQueue - 2.2 thief steals the oldest task"
+    );
+    functionReturn = heaplessWorkQueue_pop(&workQueue, 0u, &my_task);
+    testResults |= test(
+        functionReturn == true && my_task == 11u,
+        "WorkQueue - 2.3 owner pops the last task"
+    );
+    functionReturn = heaplessWorkQueue_steal(&workQueue, 0u, &my_task);
+    testResults |= test(
+        functionReturn == false,
+        "WorkQueue - 2.4 nothing to be stolen"
+    );
+
+    // ---------------------------------------------------------
+    count = 0;
+    while( heaplessWorkQueue_push(&workQueue, 1u, (tListData)count) ) count++;
+    testResults |= test(
+        count == HEAPLESS_LIST_MAX_SIZE,
+        "WorkQueue - 2.5 not possible to push more than the deque capacity"
+    );
+    while( heaplessWorkQueue_steal(&workQueue, 1u, &my_task) ) count--;
+    testResults |= test(
+        count == 0,
+        "WorkQueue - 2.6 steal all the tasks"
+    );
+
+    // void heaplessWorkQueue_run(heaplessWorkQueue* wq, tIndex worker, heaplessWorkQueue_handler handler);
+    // ---------------------------------------------------------
+    heaplessWorkQueue_init(&workQueue, workDeques, workItems, WORK_QUEUE_WORKERS, HEAPLESS_LIST_MAX_SIZE);
+    for( count = 0; count < WORK_QUEUE_TASKS; count++ ) atomic_init(&workExecuted[count], 0);
+    // all the work starts in the worker 0, the others have to steal it
+    for( count = 0; count < WORK_QUEUE_TASKS / 2; count++ ){
+        if( !heaplessWorkQueue_push(&workQueue, 0u, (tListData)count) )
+            workHandler(&workQueue, 0u, (tListData)count);
+    }
+    for( count = 0; count < WORK_QUEUE_WORKERS; count++ ){
+        pthread_create(&my_threads[count], NULL, workThread, (void*)(uintptr_t)count);
+    }
+    for( count = 0; count < WORK_QUEUE_WORKERS; count++ ){
+        pthread_join(my_threads[count], NULL);
+    }
+    functionReturn = true;
+    for( count = 0; count < WORK_QUEUE_TASKS; count++ ){
+        functionReturn &= ( 1 == atomic_load(&workExecuted[count]) );
+    }
+    testResults |= test(
+        functionReturn == true && workQueue.pendingTasks == 0,
+        "WorkQueue - 3.1 workers run every task exactly once"
+    );
+
+
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessBlockingQueue *********************/
+    /*************************************************************************************/
+    int my_sum = 0;
+    int my_expectedSum = 0;
+
+    // void heaplessBlockingQueue_init(heaplessBlockingQueue* bq, ...);
+    // bool heaplessBlockingQueue_popWait(heaplessBlockingQueue* bq, tListData* output, uint32_t timeoutMs);
+    // ---------------------------------------------------------
+    heaplessBlockingQueue_init(&blockingQueue, blockingAllocationArray, blockingMemory, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 0u);
+    testResults |= test(
+        functionReturn == false && blockingQueue.items == 0u,
+        "BlockingQueue - 1.1 pop without waiting from an empty queue"
+    );
+    functionReturn = heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 5u);
+    testResults |= test(
+        functionReturn == false,
+        "BlockingQueue - 1.2 pop gives up after the timeout"
+    );
+
+    // bool heaplessBlockingQueue_appendWait(heaplessBlockingQueue* bq, tListData data, uint32_t timeoutMs);
+    // ---------------------------------------------------------
+    count = 0;
+    while( heaplessBlockingQueue_appendWait(&blockingQueue, (tListData)count, 0u) ) count++;
+    testResults |= test(
+        count == (int)blockingQueue.items && blockingQueue.spaces == 0u &&
+        heaplessList_isFull(&blockingQueue.list),
+        "BlockingQueue - 2.1 append until the queue is full"
+    );
+    functionReturn = heaplessBlockingQueue_appendWait(&blockingQueue, 0u, 5u);
+    testResults |= test(
+        functionReturn == false,
+        "BlockingQueue - 2.2 append gives up after the timeout"
+    );
+    functionReturn = heaplessBlockingQueue_popWait(&blockingQueue, &my_data, HLL_WAIT_FOREVER);
+    testResults |= test(
+        functionReturn == true && my_data == 0u,
+        "BlockingQueue - 2.3 pop keeps the order of the list"
+    );
+    while( heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 0u) );
+
+#ifdef HLL_EPOCH_READERS
+    // ---------------------------------------------------------
+    while( heaplessBlockingQueue_appendWait(&blockingQueue, 0u, 0u) );
+    heaplessList_readBegin(&blockingQueue.list, 0u);
+    functionReturn = heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 0u);
+    functionReturn &= !heaplessBlockingQueue_appendWait(&blockingQueue, 0u, 0u); // the node waits for the reader
+    functionReturn &= ( blockingQueue.spaces == 1u && (tIndex)blockingQueue.items == heaplessList_size(&blockingQueue.list) );
+    heaplessList_readEnd(&blockingQueue.list, 0u);
+    functionReturn &= heaplessBlockingQueue_appendWait(&blockingQueue, 0u, 0u);
+    while( heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 0u) );
+    testResults |= test(
+        functionReturn == true && blockingQueue.items == 0u && heaplessList_size(&blockingQueue.list) == 0u,
+        "BlockingQueue - 2.4 failed append gives the space back"
+    );
+#endif
+
+#ifdef HLL_SEGMENTED
+    // ---------------------------------------------------------
+    functionReturn = heaplessBlockingQueue_addSegment(&blockingQueue, segmentMemory[0], HEAPLESS_LIST_MAX_SIZE);
+    count = 0;
+    while( heaplessBlockingQueue_appendWait(&blockingQueue, (tListData)count, 0u) ) count++;
+    functionReturn &= ( count == (int)heaplessList_capacity(&blockingQueue.list) && blockingQueue.spaces == 0u );
+    functionReturn &= !heaplessBlockingQueue_releaseSegment(&blockingQueue, segmentMemory[0]);
+    while( heaplessBlockingQueue_popWait(&blockingQueue, &my_data, 0u) );
+    functionReturn &= heaplessBlockingQueue_releaseSegment(&blockingQueue, segmentMemory[0]);
+    functionReturn &= !heaplessBlockingQueue_releaseSegment(&blockingQueue, segmentMemory[0]); // not attached anymore
+    testResults |= test(
+        functionReturn == true && blockingQueue.spaces == heaplessList_capacity(&blockingQueue.list),
+        "BlockingQueue - 2.5 segments attached to the queue are spaces"
+    );
+#endif
+
+    // ---------------------------------------------------------
+    pthread_create(&my_threads[0], NULL, blockingConsumer, &my_sum);
+    for( count = 0; count < BLOCKING_QUEUE_ITEMS; count++ ){
+        my_expectedSum += count;
+        (void)heaplessBlockingQueue_appendWait(&blockingQueue, (tListData)count, HLL_WAIT_FOREVER);
+    }
+    pthread_join(my_threads[0], NULL);
+    testResults |= test(
+        my_sum == my_expectedSum && blockingQueue.items == 0u,
+        "BlockingQueue - 3.1 producer waits for space and consumer waits for data"
+    );
+
+
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessPriorityList **********************/
+    /*************************************************************************************/
+    heaplessPriorityList my_pl;
+    tIndex my_nodes[4];
+
+    // void heaplessPriorityList_init(heaplessPriorityList* pl, ...);
+    // ---------------------------------------------------------
+    heaplessPriorityList_init(&my_pl, priorityAllocationArray, priorityMemory, HEAPLESS_LIST_MAX_SIZE);
+    functionReturn = heaplessPriorityList_pop(&my_pl, &my_data);
+    testResults |= test(
+        functionReturn == false && my_pl.readyBitmap == 0u,
+        "PriorityList - 1. Init priority list with all the lanes empty"
+    );
+
+    // tIndex heaplessPriorityList_push(heaplessPriorityList* pl, uint8_t priority, tListData data);
+    // bool heaplessPriorityList_pop(heaplessPriorityList* pl, tListData* output);
+    // ---------------------------------------------------------
+    my_nodes[0] = heaplessPriorityList_push(&my_pl, 3u, 30u);
+    my_nodes[1] = heaplessPriorityList_push(&my_pl, 7u, 70u);
+    my_nodes[2] = heaplessPriorityList_push(&my_pl, 3u, 31u);
+    my_nodes[3] = heaplessPriorityList_push(&my_pl, 7u, 71u);
+    testResults |= test(
+        my_pl.readyBitmap == ((1u << 3) | (1u << 7)) &&
+        HLL_NULL == heaplessPriorityList_push(&my_pl, HLL_PRIORITY_LANES, 0u),
+        "PriorityList - 2.1 push in two lanes"
+    );
+    functionReturn = heaplessPriorityList_getFirst(&my_pl, &my_data);
+    testResults |= test(
+        functionReturn == true && my_data == 70u,
+        "PriorityList - 2.2 first element is the oldest of the highest lane"
+    );
+    functionReturn = heaplessPriorityList_pop(&my_pl, &my_data);
+    functionReturn &= heaplessPriorityList_pop(&my_pl, &my_data);
+    testResults |= test(
+        functionReturn == true && my_data == 71u && my_pl.readyBitmap == (1u << 3),
+        "PriorityList - 2.3 FIFO inside the lane, and the empty lane leaves the bitmap"
+    );
+
+    // bool heaplessPriorityList_reprioritize(heaplessPriorityList* pl, tIndex node, uint8_t priority);
+    // ---------------------------------------------------------
+    functionReturn = heaplessPriorityList_reprioritize(&my_pl, my_nodes[2], 31u);
+    testResults |= test(
+        functionReturn == true && my_pl.readyBitmap == ((1u << 3) | (1u << 31)),
+        "PriorityList - 3.1 move an element to the highest lane"
+    );
+    functionReturn = heaplessPriorityList_reprioritize(&my_pl, my_nodes[1], 0u);
+    testResults |= test(
+        functionReturn == false,
+        "PriorityList - 3.2 not possible to move an element that was poped"
+    );
+    functionReturn = heaplessPriorityList_pop(&my_pl, &my_data);
+    testResults |= test(
+        functionReturn == true && my_data == 31u,
+        "PriorityList - 3.3 moved element is poped first"
+    );
+
+    // bool heaplessPriorityList_remove(heaplessPriorityList* pl, tIndex node);
+    // ---------------------------------------------------------
+    functionReturn = heaplessPriorityList_remove(&my_pl, my_nodes[0]);
+    testResults |= test(
+        functionReturn == true && my_pl.readyBitmap == 0u &&
+        my_pl.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE,
+        "PriorityList - 4.1 remove the last element"
+    );
+
+    // ---------------------------------------------------------
+    count = 0;
+    while( HLL_NULL != heaplessPriorityList_push(&my_pl, (uint8_t)(count % HLL_PRIORITY_LANES), (tListData)count) ) count++;
+    functionReturn = true;
+    while( heaplessPriorityList_pop(&my_pl, &my_data) ){
+        functionReturn &= ( my_pl.readyBitmap < (2u << (my_data % HLL_PRIORITY_LANES)) );
+        count--;
+    }
+    testResults |= test(
+        functionReturn == true && count == 0,
+        "PriorityList - 4.2 fill the list and pop from the highest to the lowest lane"
+    );
+
+
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessIntrusiveList *********************/
+    /*************************************************************************************/
+    heaplessIntrusiveList my_il;
+    intrusiveRecord* my_irec;
+    void* my_it;
+
+    // void* heaplessIntrusiveList_append(heaplessIntrusiveList* il);
+    // ---------------------------------------------------------
+    HLL_INTRUSIVE_INIT(&my_il, intrusiveAllocationArray, intrusiveRecords, intrusiveRecord, link, HEAPLESS_LIST_MAX_SIZE);
+    count = 0;
+    while( NULL_PTR != (my_irec = heaplessIntrusiveList_append(&my_il)) ){
+        my_irec->id = (uint32_t)count;
+        snprintf(my_irec->name, sizeof(my_irec->name), "rec%d", count);
+        count++;
+    }
+    my_irec = heaplessIntrusiveList_getFirst(&my_il);
+    testResults |= test(
+        count == HEAPLESS_LIST_MAX_SIZE && my_irec == &intrusiveRecords[0] &&
+        ((intrusiveRecord*)heaplessIntrusiveList_initItEnd(&my_il))->id == HEAPLESS_LIST_MAX_SIZE - 1u,
+        "IntrusiveList - 1.1 records are written in place until the list is full"
+    );
+
+    // bool heaplessIntrusiveList_remove(heaplessIntrusiveList* il, void* record);
+    // ---------------------------------------------------------
+    functionReturn = heaplessIntrusiveList_remove(&my_il, &intrusiveRecords[5]);
+    my_it = &intrusiveRecords[4];
+    (void)heaplessIntrusiveList_nextIt(&my_il, &my_it);
+    testResults |= test(
+        functionReturn == true && my_it == &intrusiveRecords[6] &&
+        heaplessIntrusiveList_remove(&my_il, &intrusiveRecords[5]) == false &&
+        heaplessIntrusiveList_remove(&my_il, (uint8_t*)&intrusiveRecords[6] + 1) == false,
+        "IntrusiveList - 2.1 remove a record from the middle only once"
+    );
+
+    // ---------------------------------------------------------
+    my_irec = heaplessIntrusiveList_append(&my_il); // the free record is used again
+    my_irec->id = 101u;
+    functionReturn = heaplessIntrusiveList_previousIt(&my_il, (void**)&my_irec);
+    testResults |= test(
+        my_irec == &intrusiveRecords[HEAPLESS_LIST_MAX_SIZE - 1] && functionReturn == true &&
+        0 == strcmp(intrusiveRecords[6].name, "rec6"),
+        "IntrusiveList - 2.2 removed record is appended again without moving the others"
+    );
+
+    // bool heaplessIntrusiveList_removeAndNextIt(heaplessIntrusiveList* il, void** record);
+    // ---------------------------------------------------------
+    functionReturn = true;
+    for( my_it = heaplessIntrusiveList_initIt(&my_il); NULL_PTR != my_it; ){
+        if( 0 == ((intrusiveRecord*)my_it)->id % 2u ) functionReturn &= heaplessIntrusiveList_removeAndNextIt(&my_il, &my_it);
+        else if( !heaplessIntrusiveList_nextIt(&my_il, &my_it) ) break;
+    }
+    count = 0;
+    for( my_it = heaplessIntrusiveList_initIt(&my_il); NULL_PTR != my_it; ){
+        functionReturn &= ( 1u == ((intrusiveRecord*)my_it)->id % 2u );
+        count++;
+        if( !heaplessIntrusiveList_nextIt(&my_il, &my_it) ) break;
+    }
+    testResults |= test(
+        functionReturn == true && count == HEAPLESS_LIST_MAX_SIZE / 2, // the odd ones of the array, 5 is now 101
+        "IntrusiveList - 3.1 remove records while iterating"
+    );
+
+    // ---------------------------------------------------------
+    while( heaplessIntrusiveList_removeLast(&my_il) );
+    testResults |= test(
+        heaplessIntrusiveList_initIt(&my_il) == NULL_PTR && heaplessIntrusiveList_removeFirst(&my_il) == false &&
+        my_il.allocationTable.lenght == HEAPLESS_LIST_MAX_SIZE,
+        "IntrusiveList - 3.2 remove all the records"
+    );
+
+    /*************************************************************************************/
+    /***************************** Testing the heaplessBTree *****************************/
+    /*************************************************************************************/
+    heaplessBTree my_bt;
+    heaplessBTree my_smallBt;
+    heaplessBTreeIt my_btIt;
+    tBTreeKey my_key;
+    tListData my_btData;
+
+    // ---------------------------------------------------------
+    heaplessBTree_init(&my_bt, btreeAllocationArray, btreeMemory, BTREE_SIZE);
+    testResults |= test(
+        heaplessBTree_size(&my_bt) == 0u && heaplessBTree_initIt(&my_bt, &my_btIt) == false &&
+        heaplessBTree_lowerBound(&my_bt, 0u, &my_btIt) == false && heaplessBTree_find(&my_bt, 0u, &my_btData) == false &&
+        heaplessBTree_erase(&my_bt, 0u) == false,
+        "BTree - 1.1 init empty tree"
+    );
+
+    // bool heaplessBTree_insert(heaplessBTree* t, tBTreeKey key, tListData data);
+    // ---------------------------------------------------------
+    functionReturn = true;
+    for( count = 0; count < (int)BTREE_KEYS; count++ ){
+        my_key = ( (tBTreeKey)count * 7919u ) % BTREE_KEYS; // all the keys, out of order
+        functionReturn &= heaplessBTree_insert(&my_bt, my_key, (tListData)(3u * my_key));
+        btreeReference[my_key] = true;
+    }
+    testResults |= test(
+        functionReturn == true && heaplessBTree_size(&my_bt) == BTREE_KEYS && my_bt.height >= 3u &&
+        btreeMatchesReference(&my_bt),
+        "BTree - 1.2 insert keys out of order"
+    );
+
+    // ---------------------------------------------------------
+    functionReturn = heaplessBTree_insert(&my_bt, 10u, 7u);
+    functionReturn &= heaplessBTree_find(&my_bt, 10u, &my_btData) && my_btData == 7u;
+    functionReturn &= heaplessBTree_insert(&my_bt, 10u, 30u);
+    testResults |= test(
+        functionReturn == true && heaplessBTree_size(&my_bt) == BTREE_KEYS &&
+        heaplessBTree_find(&my_bt, 10u, &my_btData) && my_btData == 30u &&
+        heaplessBTree_find(&my_bt, BTREE_KEYS, &my_btData) == false,
+        "BTree - 1.3 insert a key twice changes the data"
+    );
+
+    // bool heaplessBTree_lowerBound(heaplessBTree* t, tBTreeKey key, heaplessBTreeIt* it);
+    // ---------------------------------------------------------
+    count = 0;
+    functionReturn = heaplessBTree_lowerBound(&my_bt, 100u, &my_btIt) && heaplessBTree_getItKey(&my_bt, &my_btIt) == 100u;
+    do{
+        if( heaplessBTree_getItKey(&my_bt, &my_btIt) > 199u ) break;
+        count++;
+    } while( heaplessBTree_nextIt(&my_bt, &my_btIt) );
+    testResults |= test(
+        functionReturn == true && count == 100 && heaplessBTree_lowerBound(&my_bt, BTREE_KEYS, &my_btIt) == false,
+        "BTree - 2.1 range of keys"
+    );
+    testResults |= test(
+        heaplessBTree_nextIt(&my_bt, &my_btIt) == false && heaplessBTree_previousIt(&my_bt, &my_btIt) == false &&
+        heaplessBTree_getItKey(&my_bt, &my_btIt) == (tBTreeKey)~0 && heaplessBTree_getItData(&my_bt, &my_btIt) == (tListData)~0,
+        "BTree - 2.2 iterator of a failed lowerBound"
+    );
+
+    // bool heaplessBTree_erase(heaplessBTree* t, tBTreeKey key);
+    // ---------------------------------------------------------
+    functionReturn = true;
+    for( count = 0; count < (int)BTREE_KEYS; count++ ){
+        my_key = ( (tBTreeKey)count * 7919u ) % BTREE_KEYS;
+        if( 1u == my_key % 2u ){
+            functionReturn &= heaplessBTree_erase(&my_bt, my_key);
+            btreeReference[my_key] = false;
+        }
+    }
+    testResults |= test(
+        functionReturn == true && heaplessBTree_size(&my_bt) == BTREE_KEYS / 2u && heaplessBTree_erase(&my_bt, 101u) == false &&
+        btreeMatchesReference(&my_bt),
+        "BTree - 3.1 erase keys out of order"
+    );
+
+    // ---------------------------------------------------------
+    testResults |= test(
+        heaplessBTree_lowerBound(&my_bt, 101u, &my_btIt) && heaplessBTree_getItKey(&my_bt, &my_btIt) == 102u &&
+        heaplessBTree_previousIt(&my_bt, &my_btIt) && heaplessBTree_getItKey(&my_bt, &my_btIt) == 100u,
+        "BTree - 3.2 lowerBound of a key that is not in the tree"
+    );
+
+    // ---------------------------------------------------------
+    for( my_key = 0u; my_key < BTREE_KEYS; my_key += 2u ){
+        functionReturn &= heaplessBTree_erase(&my_bt, my_key);
+        btreeReference[my_key] = false;
+    }
+    testResults |= test(
+        functionReturn == true && heaplessBTree_size(&my_bt) == 0u && heaplessBTree_initIt(&my_bt, &my_btIt) == false &&
+        my_bt.allocationTable.lenght == BTREE_SIZE && btreeMatchesReference(&my_bt),
+        "BTree - 3.3 erase all the keys gives back all the nodes"
+    );
+
+    // ---------------------------------------------------------
+    heaplessBTree_init(&my_smallBt, btreeAllocationArray, btreeMemory, 3u);
+    my_key = 0u;
+    while( heaplessBTree_insert(&my_smallBt, my_key, (tListData)(3u * my_key)) ){
+        btreeReference[my_key] = true;
+        my_key++;
+    }
+    testResults |= test(
+        my_key > HLL_BTREE_ORDER && heaplessBTree_find(&my_smallBt, my_key, &my_btData) == false &&
+        heaplessBTree_insert(&my_smallBt, 0u, 0u) == true && btreeMatchesReference(&my_smallBt),
+        "BTree - 4.1 insert fails without changes when there are no nodes to split"
+    );
+
     if( 0 == testResults){
         printf("All Tests passed!\n");
     }
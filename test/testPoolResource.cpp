@@ -0,0 +1,103 @@
+#include <cstdio>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include "heaplessPoolResource.hpp"
+
+#define POOL_BLOCKS 16u
+#define POOL_BLOCK_SIZE 64u
+
+alignas(std::max_align_t) static unsigned char poolMemory[POOL_BLOCKS * POOL_BLOCK_SIZE];
+static tIndex poolFreeSlots[POOL_BLOCKS];
+
+int test(bool condition, const char* message){
+    int r = 0;
+    if (!condition){
+        printf("TEST FAILED: %s \n", message);
+        r = -1;
+    }
+    return r;
+}
+
+int main(void)
+{
+    int testResults = 0;
+    bool functionReturn;
+
+    heapless::pool_resource my_pool(poolMemory, POOL_BLOCK_SIZE, POOL_BLOCKS, poolFreeSlots,
+                                    std::pmr::new_delete_resource());
+    void* my_blocks[POOL_BLOCKS];
+    void* my_big;
+
+    // ---------------------------------------------------------
+    testResults |= test(
+        my_pool.capacity() == POOL_BLOCKS && my_pool.in_use() == 0u && my_pool.high_water_mark() == 0u &&
+        my_pool.upstream_allocations() == 0u,
+        "PoolResource - 1.1 init"
+    );
+
+    // ---------------------------------------------------------
+    functionReturn = true;
+    for( tIndex i = 0; i < POOL_BLOCKS; i++ ){
+        my_blocks[i] = my_pool.allocate(POOL_BLOCK_SIZE - i, alignof(std::max_align_t));
+        functionReturn &= ( my_blocks[i] >= static_cast<void*>(poolMemory) &&
+                            my_blocks[i] < static_cast<void*>(poolMemory + sizeof(poolMemory)) );
+    }
+    testResults |= test(
+        functionReturn == true && my_pool.in_use() == POOL_BLOCKS && my_pool.upstream_allocations() == 0u,
+        "PoolResource - 1.2 all the blocks from the pool"
+    );
+
+    // ---------------------------------------------------------
+    my_big = my_pool.allocate(8u); // pool exhausted
+    testResults |= test(
+        ( my_big < static_cast<void*>(poolMemory) || my_big >= static_cast<void*>(poolMemory + sizeof(poolMemory)) ) &&
+        my_pool.upstream_allocations() == 1u,
+        "PoolResource - 1.3 upstream when the pool is exhausted"
+    );
+    my_pool.deallocate(my_big, 8u);
+
+    // ---------------------------------------------------------
+    for( tIndex i = 0; i < POOL_BLOCKS; i++ ){
+        my_pool.deallocate(my_blocks[i], POOL_BLOCK_SIZE - i, alignof(std::max_align_t));
+    }
+    my_big = my_pool.allocate(POOL_BLOCK_SIZE + 1u); // other size
+    testResults |= test(
+        my_pool.in_use() == 0u && my_pool.high_water_mark() == POOL_BLOCKS && my_pool.upstream_allocations() == 2u,
+        "PoolResource - 1.4 free all the blocks, bigger sizes from upstream"
+    );
+    my_pool.deallocate(my_big, POOL_BLOCK_SIZE + 1u);
+
+    // ---------------------------------------------------------
+    my_pool.reset_high_water_mark();
+    {
+        std::pmr::list<int> my_list(&my_pool);
+        std::pmr::map<int, int> my_map(&my_pool);
+        int sum = 0;
+
+        for( int i = 0; i < 5; i++ ){
+            my_list.push_back(i);
+            my_map[i] = i * 10;
+        }
+        my_list.pop_front();
+        my_map.erase(0);
+        for( int v : my_list ) sum += v;
+        for( auto& kv : my_map ) sum += kv.second;
+
+        testResults |= test(
+            sum == 10 + 100 && my_pool.in_use() == 8u && my_pool.high_water_mark() == 10u &&
+            my_pool.upstream_allocations() == 2u,
+            "PoolResource - 2.1 pmr list and map nodes from the pool"
+        );
+    }
+    testResults |= test(
+        my_pool.in_use() == 0u,
+        "PoolResource - 2.2 containers give back the blocks"
+    );
+
+    if( 0 == testResults){
+        printf("All Tests passed!\n");
+    }
+
+    return testResults;
+}